@@ -0,0 +1,290 @@
+#ifndef __COMPACTDATALOOP_H__
+#define __COMPACTDATALOOP_H__
+
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \class CompactDataLoop
+ * \brief A dataloop whose nodes live in one vector and are linked by 32-bit indices
+ *
+ * \detail Each node holds its value and the indices of its neighbours instead of two pointers, so a node of int takes 12 bytes rather than the 24 of a DataLoop node on a 64-bit platform. Nodes are allocated by growing the vector, which amortizes allocation, and a removed node's slot is kept on a free list and reused by the next value added. compact() gives the free slots back and lays the nodes out in loop order. A CompactDataLoop holds at most 2^32 - 1 nodes. Since growing the vector moves the nodes, there are no handles; positions are counted from start as in DataLoop.
+ */
+template<typename T>
+class CompactDataLoop {
+  struct _Node;
+
+    public:
+  /**
+   * \class basic_iterator
+   * \brief A bidirectional iterator that visits each node once, beginning at start
+   *
+   * \detail Since the loop has no last node, the iterator also counts its steps from start, and end() is start after count steps. Adding values to the loop may move the nodes, which invalidates every iterator.
+   */
+  template<bool Const>
+  class basic_iterator {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T, T>::type * pointer;
+    typedef typename std::conditional<Const, const T, T>::type & reference;
+    typedef typename std::conditional<Const, const std::vector<_Node>, std::vector<_Node>>::type storage;
+
+    basic_iterator() : nodes(nullptr), index(0), steps(0) { }
+
+    /// a const_iterator can be made from an iterator
+    template<bool C = Const, typename = typename std::enable_if<C>::type>
+    basic_iterator(const basic_iterator<false> & it) : nodes(it.nodes), index(it.index), steps(it.steps) { }
+
+    reference operator*() const { return (*nodes)[index].data; }
+    pointer operator->() const { return &(*nodes)[index].data; }
+
+    basic_iterator & operator++() {
+      index = (*nodes)[index].next;
+      steps++;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator old = *this;
+      ++*this;
+      return old;
+    }
+    basic_iterator & operator--() {
+      index = (*nodes)[index].prev;
+      steps--;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const basic_iterator & rhs) const { return steps == rhs.steps && nodes == rhs.nodes; }
+    bool operator!=(const basic_iterator & rhs) const { return !(*this == rhs); }
+
+  private:
+    friend class CompactDataLoop;
+    friend class basic_iterator<!Const>;
+    basic_iterator(storage * n, uint32_t i, size_t s) : nodes(n), index(i), steps(s) { }
+
+    storage *nodes;  ///< the node vector of the loop being iterated
+    uint32_t index;  ///< the index of the current node
+    size_t steps;    ///< the number of steps taken from start
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  /**
+   * \brief The default constructor
+   *
+   * \detail Creates an empty CompactDataLoop
+   */
+  CompactDataLoop();
+
+  /**
+   * \brief An alternate constructor
+   *
+   * \detail Creates a CompactDataLoop with one node holding value
+   */
+  CompactDataLoop(const T & value);
+
+  /**
+   * \brief The copy constructor
+   *
+   * \detail The copy holds the values of rhs in the same order, laid out compactly
+   */
+  CompactDataLoop(const CompactDataLoop & rhs);
+
+  /**
+   * \brief The move constructor
+   *
+   * \detail Takes over the node vector of rhs and leaves rhs empty
+   */
+  CompactDataLoop(CompactDataLoop && rhs);
+
+  /**
+   * \brief Overloaded operator= to assign a CompactDataLoop to another CompactDataLoop
+   */
+  CompactDataLoop & operator=(const CompactDataLoop & rhs);
+
+  /**
+   * \brief Overloaded move operator= to hand the node vector of a CompactDataLoop to another CompactDataLoop
+   */
+  CompactDataLoop & operator=(CompactDataLoop && rhs);
+
+  /**
+   * \brief Function clear to remove every node and release the node vector
+   */
+  void clear();
+
+
+  /**
+   * \brief Overloaded operator== to check if two CompactDataLoops hold the same values in the same order from start
+   */
+  bool operator==(const CompactDataLoop & rhs) const;
+
+
+  /**
+   * \brief Overloaded operator+= to add a value to the end of this CompactDataLoop
+   *
+   * \detail The node goes in a free slot if there is one, otherwise at the back of the node vector.
+   *
+   * \throw std::length_error if the loop already holds 2^32 - 1 nodes
+   *
+   * \return A reference to the updated CompactDataLoop
+   */
+  CompactDataLoop & operator+=(const T & value);
+
+
+  /**
+   * \brief Overloaded operator+ to concatenate copies of two CompactDataLoops
+   */
+  CompactDataLoop operator+(const CompactDataLoop & rhs) const;
+
+
+  /**
+   * \brief Overloaded operator^ to shift the start position forward for a positive offset and backward for a negative offset
+   */
+  CompactDataLoop & operator^(int offset);
+
+
+  /**
+   * \brief Function splice to insert an entire CompactDataLoop into this one
+   *
+   * \detail As DataLoop::splice, position 0 inserts rhs before start and makes the start of rhs the new start, and position n inserts rhs after node n, looping around as needed. rhs is left empty. If *this is empty the node vector of rhs is taken over in O(1); otherwise the values of rhs are moved into free slots or onto the back of the node vector of *this, since nodes cannot be shared between two vectors.
+   *
+   * \param[in] rhs A reference to a CompactDataLoop object to insert into *this
+   *
+   * \param[in] pos The insertion position
+   *
+   * \throw std::length_error if the result would hold more than 2^32 - 1 nodes; neither loop is changed
+   *
+   * \return A reference to the updated CompactDataLoop object
+   */
+  CompactDataLoop & splice(CompactDataLoop & rhs, size_t pos);
+
+
+  /**
+   * \brief Function remove_at_offset to shift the start position and remove the node found there
+   *
+   * \detail The start moves by offset as with operator^, that node is removed and the node after it becomes the start. Its slot goes on the free list.
+   *
+   * \throw std::out_of_range if the CompactDataLoop is empty
+   *
+   * \return The value of the removed node
+   */
+  T remove_at_offset(int offset);
+
+
+  /**
+   * \brief Function remove_if to remove every node whose value satisfies pred
+   *
+   * \detail The slots of the removed nodes go on the free list. If start is removed, the first remaining node after it becomes the start.
+   *
+   * \return The number of nodes removed
+   */
+  size_t remove_if(const std::function<bool(const T &)> & pred);
+
+
+  /**
+   * \brief Function compact to give back the free slots of the node vector
+   *
+   * \detail Moves the values into a new vector of exactly length() nodes laid out in loop order from start, so that walking the loop also walks memory in order. Every iterator is invalidated.
+   *
+   * \return The number of slots reclaimed
+   */
+  size_t compact();
+
+
+  /**
+   * \brief Function reserve to make room for at least n nodes without further allocation
+   */
+  void reserve(size_t n) { nodes.reserve(n); }
+
+
+  /**
+   * \brief Function slots to report the number of nodes in the node vector, in use or free
+   */
+  size_t slots() const { return nodes.size(); }
+
+
+  /**
+   * \brief Function free_slots to report the number of slots on the free list
+   */
+  size_t free_slots() const { return nodes.size() - count; }
+
+
+  /**
+   * \brief Function length to report the number of nodes in *this CompactDataLoop
+   */
+  int length() const { return static_cast<int>(count); }
+
+
+  /**
+   * \brief Functions begin and end to iterate over the CompactDataLoop from the start node
+   */
+  iterator begin() { return iterator(&nodes, start, 0); }
+  iterator end() { return iterator(&nodes, start, count); }
+  const_iterator begin() const { return const_iterator(&nodes, start, 0); }
+  const_iterator end() const { return const_iterator(&nodes, start, count); }
+
+
+  /**
+   * \brief Overloaded output stream operator<< to print the CompactDataLoop
+   *
+   * \detail Prints "-> data1 <--> data2 <--> ... <--> datax <-" where data1 is the value in the start node, or ">no values<" if the CompactDataLoop is empty.
+   */
+  template<typename U>
+  friend std::ostream & operator<<(std::ostream & os, const CompactDataLoop<U> & dl);
+
+private:
+  /// friend CompactDataLoopTest struct to allow the test struct access to the private data
+  friend struct CompactDataLoopTest;
+
+  /// the index that refers to no node
+  enum : uint32_t { none = 0xFFFFFFFFu };
+
+  /**
+   * \struct _Node
+   * \brief A private structure to represent a node in a CompactDataLoop
+   */
+  struct _Node {
+    T data;         ///< the node data
+    uint32_t next;  ///< the index of the next node, or of the next free slot while on the free list
+    uint32_t prev;  ///< the index of the previous node
+  };
+
+  /// stores value in a free slot or at the back of the node vector and returns its index, unlinked
+  uint32_t make_node(const T & value);
+  uint32_t make_node(T && value);
+
+  /// puts slot i on the free list; its value stays until the slot is reused or compacted
+  void free_node(uint32_t i);
+
+  /// links node i into the loop immediately before pos, or as the only node if the loop is empty
+  void link_before(uint32_t pos, uint32_t i);
+
+  /// takes node i out of the loop without freeing it
+  void unlink(uint32_t i);
+
+  /// the index of the node pos positions after start
+  uint32_t index_at(size_t pos) const;
+
+  std::vector<_Node> nodes;  ///< every node, in use or free
+  uint32_t start;            ///< the index of the start node, or none if the loop is empty
+  uint32_t free_head;        ///< the first slot on the free list, or none
+  size_t count;              ///< the number of nodes in the loop
+};
+
+#include "CompactDataLoop.inc"
+#endif // __COMPACTDATALOOP_H__
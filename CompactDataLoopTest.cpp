@@ -0,0 +1,409 @@
+#include "CompactDataLoop.h"
+#include "TDataLoop.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using std::cout;
+using std::endl;
+using std::string;
+
+#ifndef ASSERT
+#include <csignal>  // signal handler 
+#include <cstring>  // memset
+
+char programName[128];
+
+void segFaultHandler(int, siginfo_t*, void* context) {
+  char cmdbuffer[1024];
+  char resultbuffer[128];
+#ifdef __APPLE__
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext->__ss.__rip);
+#else
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+  std::string result = "";
+  FILE* pipe = popen(cmdbuffer, "r");
+  if (!pipe) throw std::runtime_error("popen() failed!");
+  try {
+    while (fgets(resultbuffer, sizeof resultbuffer, pipe) != NULL) {
+      result += resultbuffer;
+    }
+  } catch (...) {
+    pclose(pipe);
+    throw;
+  }
+  pclose(pipe);
+  cout << "Segmentation fault occured in " << result;
+#ifdef __APPLE__
+  ((ucontext_t*)context)->uc_mcontext->__ss.__rip += 2;  // skip the seg fault
+#else
+  ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP] += 2;  // skip the seg fault
+#endif
+}
+
+#define ASSERT(cond) if (!(cond)) { \
+    cout << "failed ASSERT " << #cond << " at line " << __LINE__ << endl; \
+  } else { \
+    cout << __func__ << " - (" << #cond << ")" << " passed!" << endl; \
+  }
+#endif
+
+/**
+ * \struct CompactDataLoopTest
+ * \defgroup CompactDataLoopTest
+ * \brief Test cases for the CompactDataLoop class
+ */
+struct CompactDataLoopTest {
+  // aliases
+  using ICDataLoop = CompactDataLoop<int>;
+  using SCDataLoop = CompactDataLoop<string>;
+
+  /// prints any printable object, for comparing the formats of two kinds of loop
+  template<typename Loop>
+  static string text(const Loop & dl) {
+    std::stringstream ss;
+    ss << dl;
+    return ss.str();
+  }
+
+  /**
+   * \brief A test function for the constructors and the node layout
+   */
+  static void ConstructorTest() {
+    ICDataLoop empty;
+    ASSERT(empty.start == ICDataLoop::none);
+    ASSERT(empty.count == 0);
+    ASSERT(empty.slots() == 0);
+    ASSERT(text(empty) == ">no values<");
+
+    ICDataLoop one(5);
+    ASSERT(one.count == 1);
+    ASSERT(one.nodes[one.start].next == one.start);
+    ASSERT(one.nodes[one.start].prev == one.start);
+
+    // two 32-bit links around an int
+    ASSERT(sizeof(ICDataLoop::_Node) == 12);
+
+    SCDataLoop s("hi");
+    s += "there";
+    SCDataLoop copy(s);
+    ASSERT(copy == s);
+    SCDataLoop moved(std::move(copy));
+    ASSERT(moved == s);
+    ASSERT(copy.length() == 0);
+    ASSERT(copy.slots() == 0);
+
+    // my tests
+    ICDataLoop a;
+    a = one;
+    a = a;
+    ASSERT(a == one);
+    a = ICDataLoop();
+    ASSERT(a.length() == 0);
+  }
+
+  /**
+   * \brief A test function for operator+=, operator+ and operator<<
+   */
+  static void OperatorPlusGetsTest() {
+    ICDataLoop a;
+    TDataLoop<int> t;
+    for (int i = 1; i <= 5; i++) {
+      a += i;
+      t += i;
+    }
+    ASSERT(a.length() == 5);
+    ASSERT(text(a) == "-> 1 <--> 2 <--> 3 <--> 4 <--> 5 <-");
+    ASSERT(text(a) == text(t));
+    ASSERT(a.slots() == 5);
+
+    ICDataLoop b;
+    b += 6;
+    ICDataLoop c = a + b;
+    ASSERT(text(c) == "-> 1 <--> 2 <--> 3 <--> 4 <--> 5 <--> 6 <-");
+    ASSERT(a.length() == 5);
+    ASSERT(text(ICDataLoop() + ICDataLoop()) == ">no values<");
+
+    // a value of the loop itself can be added while the vector grows
+    SCDataLoop s;
+    s += "a";
+    for (int i = 0; i < 6; i++) {
+      s += *s.begin();
+    }
+    ASSERT(s.length() == 7);
+    ASSERT(text(s) == "-> a <--> a <--> a <--> a <--> a <--> a <--> a <-");
+
+    // my tests
+    ICDataLoop d;
+    d += 1;
+    d += 2;
+    ASSERT(!(d == a));
+    ICDataLoop::iterator it = d.begin();
+    *it = 7;
+    ICDataLoop::const_iterator cit = it;
+    ASSERT(*cit == 7);
+    ASSERT(++cit != d.end());
+    ASSERT(++cit == d.end());
+  }
+
+  /**
+   * \brief A test function for operator^
+   */
+  static void OperatorShiftTest() {
+    ICDataLoop a;
+    TDataLoop<int> t;
+    for (int i = 1; i <= 5; i++) {
+      a += i;
+      t += i;
+    }
+
+    int offsets[] = {2, -3, 11, -12, 0, 4, -1};
+    bool same = true;
+    for (int offset : offsets) {
+      a ^ offset;
+      t ^ offset;
+      same = same && text(a) == text(t);
+    }
+    ASSERT(same);
+
+    // my tests
+    ICDataLoop empty;
+    empty ^ 3;
+    ASSERT(empty.length() == 0);
+  }
+
+  /**
+   * \brief A test function for splice
+   */
+  static void FunctionSpliceTest() {
+    // the same positions as DataLoop, including those past the end
+    bool same = true;
+    for (size_t pos = 0; pos < 9; pos++) {
+      ICDataLoop a;
+      ICDataLoop b;
+      TDataLoop<int> ta;
+      TDataLoop<int> tb;
+      for (int i = 1; i <= 4; i++) {
+        a += i;
+        ta += i;
+      }
+      for (int i = 7; i <= 9; i++) {
+        b += i;
+        tb += i;
+      }
+      a.splice(b, pos);
+      ta.splice(tb, pos);
+      same = same && text(a) == text(ta) && b.length() == 0 && b.slots() == 0;
+    }
+    ASSERT(same);
+
+    ICDataLoop a;
+    a += 1;
+    a += 2;
+    ICDataLoop b;
+    b += 3;
+    b += 4;
+    b ^ 1;
+    a.splice(b, 1);
+    ASSERT(text(a) == "-> 1 <--> 4 <--> 3 <--> 2 <-");
+    ASSERT(a.length() == 4);
+
+    // an empty loop takes over the nodes of rhs
+    ICDataLoop empty;
+    empty.splice(a, 3);
+    ASSERT(text(empty) == "-> 1 <--> 4 <--> 3 <--> 2 <-");
+    ASSERT(a.length() == 0);
+    empty.splice(a, 0);
+    ASSERT(empty.length() == 4);
+    empty.splice(empty, 1);
+    ASSERT(empty.length() == 4);
+
+    // the spliced values reuse free slots first
+    SCDataLoop s;
+    s += "a";
+    s += "b";
+    s += "c";
+    s.remove_at_offset(1);
+    SCDataLoop r;
+    r += "x";
+    r += "y";
+    s.splice(r, 0);
+    ASSERT(text(s) == "-> x <--> y <--> c <--> a <-");
+    ASSERT(s.slots() == 4);
+    ASSERT(s.free_slots() == 0);
+
+    // my tests
+    SCDataLoop none;
+    s.splice(none, 2);
+    ASSERT(s.length() == 4);
+  }
+
+  /**
+   * \brief A test function for remove_at_offset and remove_if
+   */
+  static void FunctionRemoveTest() {
+    ICDataLoop a;
+    for (int i = 1; i <= 6; i++) {
+      a += i;
+    }
+    ASSERT(a.remove_at_offset(2) == 3);
+    ASSERT(text(a) == "-> 4 <--> 5 <--> 6 <--> 1 <--> 2 <-");
+    ASSERT(a.free_slots() == 1);
+
+    // the freed slot is used again before the vector grows
+    a += 10;
+    ASSERT(a.slots() == 6);
+    ASSERT(a.free_slots() == 0);
+    ASSERT(text(a) == "-> 4 <--> 5 <--> 6 <--> 1 <--> 2 <--> 10 <-");
+
+    ASSERT(a.remove_if([](const int & x) { return x % 2 == 0; }) == 4);
+    ASSERT(text(a) == "-> 5 <--> 1 <-");
+    ASSERT(a.free_slots() == 4);
+    ASSERT(a.remove_if([](const int &) { return true; }) == 2);
+    ASSERT(text(a) == ">no values<");
+
+    bool threw = false;
+    try {
+      a.remove_at_offset(0);
+    }
+    catch (const std::out_of_range &) {
+      threw = true;
+    }
+    ASSERT(threw);
+
+    // my tests
+    // the free list runs through the next indices, newest slot first, and ends at none
+    ICDataLoop f;
+    for (int i = 0; i < 4; i++) {
+      f += i;
+    }
+    f.remove_at_offset(1);
+    f.remove_at_offset(1);
+    ASSERT(f.free_head == 3);
+    ASSERT(f.nodes[3].next == 1);
+    ASSERT(f.nodes[1].next == ICDataLoop::none);
+    f.remove_if([](const int &) { return true; });
+    ASSERT(f.start == ICDataLoop::none);
+    uint32_t on_list = 0;
+    for (uint32_t i = f.free_head; i != ICDataLoop::none; i = f.nodes[i].next) {
+      on_list++;
+    }
+    ASSERT(on_list == 4);
+  }
+
+  /**
+   * \brief A test function for the limit of 2^32 - 1 nodes that 32-bit links allow
+   */
+  static void IndexLimitTest() {
+    // the count is raised by hand, since filling 2^32 - 1 real nodes would take tens of gigabytes
+    ICDataLoop a;
+    a += 1;
+    a += 2;
+    ICDataLoop b;
+    b += 3;
+    b += 4;
+    size_t real = a.count;
+    a.count = static_cast<size_t>(ICDataLoop::none) - 1;
+    bool threw = false;
+    try {
+      a.splice(b, 0);
+    }
+    catch (const std::length_error &) {
+      threw = true;
+    }
+    ASSERT(threw);
+    ASSERT(b.length() == 2);
+    ASSERT(a.slots() == 2);
+
+    // exactly 2^32 - 1 nodes still fit, since none is the only index that names no node
+    a.count = static_cast<size_t>(ICDataLoop::none) - 2;
+    a.splice(b, 0);
+    ASSERT(a.count == static_cast<size_t>(ICDataLoop::none));
+    ASSERT(a.start == 2);
+    ASSERT(a.nodes[3].next == 0);
+    ASSERT(a.nodes[0].prev == 3);
+    a.count = real + 2;
+    ASSERT(text(a) == "-> 3 <--> 4 <--> 1 <--> 2 <-");
+
+    // my tests
+    // an index is 4 bytes, so a node of int takes half the room of a DataLoop node
+    ASSERT(sizeof(ICDataLoop::_Node) == 12);
+  }
+
+  /**
+   * \brief A test function for compact
+   */
+  static void FunctionCompactTest() {
+    ICDataLoop a;
+    for (int i = 0; i < 100; i++) {
+      a += i;
+    }
+    a.remove_if([](const int & x) { return x % 3 != 0; });
+    a ^ 5;
+    ASSERT(a.length() == 34);
+    ASSERT(a.slots() == 100);
+    string before = text(a);
+
+    ASSERT(a.compact() == 66);
+    ASSERT(a.slots() == 34);
+    ASSERT(a.nodes.capacity() == 34);
+    ASSERT(a.free_slots() == 0);
+    ASSERT(text(a) == before);
+
+    // the nodes are laid out in loop order from start
+    bool in_order = a.start == 0;
+    for (uint32_t i = 0; i < 34; i++) {
+      in_order = in_order && a.nodes[i].next == (i + 1) % 34 && a.nodes[i].data == (15 + 3 * static_cast<int>(i)) % 102;
+    }
+    ASSERT(in_order);
+    ASSERT(a.nodes[0].data == 15);
+    ASSERT(a.nodes[33].data == 12);
+    ASSERT(a.nodes[0].prev == 33);
+
+    // nothing to do the second time
+    ASSERT(a.compact() == 0);
+    ASSERT(text(a) == before);
+
+    // a rotated loop with no free slots is still put in order
+    a ^ 1;
+    ASSERT(a.compact() == 0);
+    ASSERT(a.start == 0);
+    ASSERT(a.nodes[0].data == 18);
+
+    // my tests
+    SCDataLoop s;
+    s += "a";
+    s += "b";
+    s.remove_at_offset(0);
+    s.remove_at_offset(0);
+    ASSERT(s.compact() == 2);
+    ASSERT(s.slots() == 0);
+    ASSERT(s.start == SCDataLoop::none);
+    s += "c";
+    ASSERT(text(s) == "-> c <-");
+  }
+};
+
+int main(int, char* argv[]) {
+  cout << "Testing CompactDataLoop" << endl;
+  // register a seg fault handler
+  sprintf(programName, "%s", argv[0]);
+  struct sigaction signalAction;
+  memset(&signalAction, 0, sizeof(struct sigaction));
+  signalAction.sa_flags = SA_SIGINFO;
+  signalAction.sa_sigaction = segFaultHandler;
+  sigaction(SIGSEGV, &signalAction, NULL);
+
+  CompactDataLoopTest::ConstructorTest();   // int, string
+  CompactDataLoopTest::OperatorPlusGetsTest();   // int, string
+  CompactDataLoopTest::OperatorShiftTest();   // int
+  CompactDataLoopTest::FunctionSpliceTest();   // int, string
+  CompactDataLoopTest::FunctionRemoveTest();   // int, string
+  CompactDataLoopTest::FunctionCompactTest();   // int, string
+  CompactDataLoopTest::IndexLimitTest();   // int
+  
+  return 0;
+}
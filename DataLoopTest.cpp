@@ -2,6 +2,8 @@
 #include <iostream>
 #include <sstream>
 #include <stdlib.h> // abs function
+#include <algorithm>
+#include <numeric>
 
 using std::cout;
 using std::endl;
@@ -579,6 +581,839 @@ struct DataLoopTest {
 
   }
 
+  /**
+   * \brief A test function for remove_at_offset and eliminate_every
+   */
+  static void FunctionEliminateTest() {
+    DataLoop *q = new DataLoop();
+    for (int i = 1; i <= 10; i++) {
+      *q += i;
+    }
+    ASSERT(q->remove_at_offset(3) == 4);
+    ASSERT(q->count == 9);
+    ASSERT(q->start->data == 5);
+    ASSERT(q->start->prev->data == 3);
+    ASSERT(q->remove_at_offset(-1) == 3);
+    ASSERT(q->start->data == 5);
+    ASSERT(q->remove_at_offset(14) == 1);
+    ASSERT(q->start->data == 2);
+    std::stringstream ss;
+    ss << *q;
+    ASSERT(ss.str() == "-> 2 <--> 5 <--> 6 <--> 7 <--> 8 <--> 9 <--> 10 <-");
+    delete q;
+
+    // every second node goes, so 5 is the last one standing
+    DataLoop *r = new DataLoop();
+    for (int i = 1; i <= 10; i++) {
+      *r += i;
+    }
+    std::vector<int> order = r->eliminate_every(1);
+    int expected[] = {2, 4, 6, 8, 10, 3, 7, 1, 9, 5};
+    ASSERT(order.size() == 10);
+    ASSERT(std::equal(order.begin(), order.end(), expected));
+    ASSERT(r->count == 0);
+    ASSERT(r->start == nullptr);
+    delete r;
+
+    // my tests
+    // the classic 41 people, every third: the survivor is 31
+    DataLoop *m = new DataLoop();
+    for (int i = 1; i <= 41; i++) {
+      *m += i;
+    }
+    int last = 0;
+    m->eliminate_every(2, [&last](const int & value) { last = value; });
+    ASSERT(last == 31);
+    ASSERT(m->length() == 0);
+
+    // eliminate_every matches repeated remove_at_offset, including negative offsets
+    DataLoop *a = new DataLoop();
+    DataLoop *k = new DataLoop();
+    for (int i = 1; i <= 12; i++) {
+      *a += i;
+      *k += i;
+    }
+    std::vector<int> fast = a->eliminate_every(-5);
+    bool same = true;
+    for (size_t i = 0; i < fast.size(); i++) {
+      same = same && fast[i] == k->remove_at_offset(-5);
+    }
+    ASSERT(same);
+    ASSERT(fast.size() == 12);
+    ASSERT(k->count == 0);
+
+    delete m;
+    delete a;
+    delete k;
+  }
+
+  /**
+   * \brief A test function for handles, iterators and O(1) insert/erase, depends on operator<<
+   */
+  static void FunctionHandleTest() {
+    DataLoop *q = new DataLoop();
+    for (int i = 1; i <= 4; i++) {
+      *q += i;
+    }
+    DataLoop::handle two = q->handle_at(1);
+    DataLoop::handle four = q->handle_at(7);
+    ASSERT(*two == 2);
+    ASSERT(*four == 4);
+    ASSERT(q->next(four) == q->start_handle());
+    ASSERT(q->prev(two) == q->start_handle());
+
+    DataLoop::handle ten = q->insert_after(two, 10);
+    q->insert_before(two, 20);
+    q->insert_before(q->start_handle(), 30);   // same as += 30
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> 1 <--> 20 <--> 2 <--> 10 <--> 3 <--> 4 <--> 30 <-");
+    ASSERT(q->count == 7);
+
+    // handles stay valid across unrelated changes
+    ASSERT(q->erase(two) == ten);
+    *q += 40;
+    q->move_to_start(four);
+    std::stringstream ss2;
+    ss2 << *q;
+    ASSERT(ss2.str() == "-> 4 <--> 1 <--> 20 <--> 10 <--> 3 <--> 30 <--> 40 <-");
+    ASSERT(*ten == 10);
+    ASSERT(q->start->prev->data == 40);
+    ASSERT(q->start->next->data == 1);
+
+    // erasing the start node moves start forward
+    q->erase(q->start_handle());
+    ASSERT(q->start->data == 1);
+    ASSERT(q->count == 6);
+
+    // iterators visit each node once from start, and work with std algorithms
+    int sum = 0;
+    for (DataLoop::iterator it = q->begin(); it != q->end(); ++it) {
+      sum += *it;
+    }
+    ASSERT(sum == 104);
+    ASSERT(std::accumulate(q->begin(), q->end(), 0) == 104);
+    ASSERT(*std::find(q->begin(), q->end(), 3) == 3);
+    ASSERT(*--q->end() == 40);
+    const DataLoop *c = q;
+    ASSERT(std::distance(c->begin(), c->end()) == 6);
+    delete q;
+
+    // my tests
+    DataLoop *m = new DataLoop(5);
+    DataLoop::handle only = m->start_handle();
+    ASSERT(!m->erase(only));
+    ASSERT(m->start == nullptr);
+    ASSERT(m->count == 0);
+    ASSERT(m->begin() == m->end());
+    ASSERT(!m->start_handle());
+    ASSERT(!m->handle_at(3));
+    delete m;
+  }
+
+  /**
+   * \brief A test function for split, split_into and moving, depends on operator<<
+   */
+  static void FunctionSplitTest() {
+    DataLoop *q = new DataLoop();
+    for (int i = 1; i <= 10; i++) {
+      *q += i;
+    }
+    DataLoop::handle nine = q->handle_at(8);
+
+    // a run that wraps past the last node takes start with it
+    DataLoop part = q->split(8, 4);
+    ASSERT(part.count == 4);
+    ASSERT(part.start_handle() == nine);   // relinked, not copied
+    ASSERT(q->count == 6);
+    ASSERT(q->start->data == 3);
+    std::stringstream ss1;
+    ss1 << part << " " << *q;
+    ASSERT(ss1.str() == "-> 9 <--> 10 <--> 1 <--> 2 <- -> 3 <--> 4 <--> 5 <--> 6 <--> 7 <--> 8 <-");
+    ASSERT(part.start->prev->data == 2);
+    ASSERT(q->start->prev->data == 8);
+
+    // split by handles
+    DataLoop middle = q->split(q->handle_at(2), q->handle_at(4));
+    std::stringstream ss2;
+    ss2 << middle << " " << *q;
+    ASSERT(ss2.str() == "-> 5 <--> 6 <--> 7 <- -> 3 <--> 4 <--> 8 <-");
+
+    // splice puts the pieces back together
+    q->splice(middle, 2);
+    std::stringstream ss3;
+    ss3 << *q;
+    ASSERT(ss3.str() == "-> 3 <--> 4 <--> 5 <--> 6 <--> 7 <--> 8 <-");
+
+    // the whole loop, and nothing
+    DataLoop all = q->split(3, 6);
+    ASSERT(q->count == 0);
+    ASSERT(q->start == nullptr);
+    ASSERT(all.count == 6);
+    ASSERT(all.start->data == 6);
+    ASSERT(q->split(0, 5).count == 0);
+    delete q;
+
+    // moving takes the nodes without copying
+    DataLoop::handle six = all.start_handle();
+    DataLoop moved(std::move(all));
+    ASSERT(all.count == 0);
+    ASSERT(all.start == nullptr);
+    ASSERT(moved.start_handle() == six);
+    all = std::move(moved);
+    ASSERT(all.start_handle() == six);
+    ASSERT(moved.count == 0);
+
+    // my tests
+    DataLoop *m = new DataLoop();
+    for (int i = 1; i <= 10; i++) {
+      *m += i;
+    }
+    std::vector<DataLoop> parts = m->split_into(3);
+    ASSERT(parts.size() == 3);
+    ASSERT(m->count == 0);
+    std::stringstream ss4;
+    ss4 << parts[0] << " " << parts[1] << " " << parts[2];
+    ASSERT(ss4.str() == "-> 1 <--> 2 <--> 3 <--> 4 <- -> 5 <--> 6 <--> 7 <- -> 8 <--> 9 <--> 10 <-");
+
+    std::vector<DataLoop> few = parts[1].split_into(5);
+    ASSERT(few.size() == 5);
+    ASSERT(few[2].length() == 1);
+    ASSERT(few[3].length() == 0);
+    ASSERT(few[4].start == nullptr);
+    delete m;
+  }
+
+  /**
+   * \brief A test function for splice_many, depends on operator<< and operator+=
+   */
+  static void FunctionSpliceManyTest() {
+    DataLoop *q = new DataLoop();
+    for (int i = 1; i <= 5; i++) {
+      *q += i;
+    }
+    DataLoop a, b(20), c(30), d(40), e(50), empty;
+    a += 10; a += 11;
+    DataLoop::handle ten = a.start_handle();
+
+    // positions refer to q before the call; equal positions keep their order
+    std::vector<std::pair<DataLoop *, size_t>> entries;
+    entries.push_back(std::make_pair(&a, 2));
+    entries.push_back(std::make_pair(&b, 0));
+    entries.push_back(std::make_pair(&c, 5));
+    entries.push_back(std::make_pair(&d, 2));
+    entries.push_back(std::make_pair(&empty, 1));
+    entries.push_back(std::make_pair(&e, 7));
+    q->splice_many(entries);
+
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> 20 <--> 1 <--> 2 <--> 10 <--> 11 <--> 40 <--> 50 <--> 3 <--> 4 <--> 5 <--> 30 <-");
+    ASSERT(q->count == 11);
+    ASSERT(q->start->prev->data == 30);
+    ASSERT(q->handle_at(3) == ten);   // relinked, not copied
+    ASSERT(a.count == 0 && a.start == nullptr);
+    ASSERT(b.count == 0 && c.count == 0 && d.count == 0 && e.count == 0);
+
+    // the single splice relinks too
+    DataLoop f(60);
+    DataLoop::handle sixty = f.start_handle();
+    q->splice(f, 11);
+    ASSERT(q->start->prev->data == 60);
+    ASSERT(q->prev(q->start_handle()) == sixty);
+    delete q;
+
+    // my tests
+    // splicing into an empty loop joins the loops in position order
+    DataLoop *m = new DataLoop();
+    DataLoop x(1), y(2), z(3);
+    std::vector<std::pair<DataLoop *, size_t>> more;
+    more.push_back(std::make_pair(&y, 4));
+    more.push_back(std::make_pair(&x, 0));
+    more.push_back(std::make_pair(m, 0));
+    more.push_back(std::make_pair(&z, 9));
+    m->splice_many(more);
+    std::stringstream ss2;
+    ss2 << *m;
+    ASSERT(ss2.str() == "-> 1 <--> 2 <--> 3 <-");
+    ASSERT(m->start->prev->data == 3);
+    delete m;
+  }
+
+  /**
+   * \brief A test function for reverse and materialize_reverse, depends on operator<<
+   */
+  static void FunctionReverseTest() {
+    DataLoop *q = new DataLoop();
+    for (int i = 1; i <= 5; i++) {
+      *q += i;
+    }
+    DataLoop::_Node *first = q->start;
+    q->reverse();
+    ASSERT(q->start == first);              // O(1): nothing relinked
+    ASSERT(q->start->next->data == 2);
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> 1 <--> 5 <--> 4 <--> 3 <--> 2 <-");
+
+    // every operation follows the reversed order
+    *q += 6;
+    *q ^ 1;
+    ASSERT(q->start->data == 5);
+    *q ^ -2;
+    ASSERT(q->start->data == 6);
+    std::stringstream ss2;
+    ss2 << *q;
+    ASSERT(ss2.str() == "-> 6 <--> 1 <--> 5 <--> 4 <--> 3 <--> 2 <-");
+    ASSERT(*q->next(q->start_handle()) == 1);
+    ASSERT(*q->prev(q->start_handle()) == 2);
+    ASSERT(*q->handle_at(2) == 5);
+    ASSERT(std::accumulate(q->begin(), q->end(), std::string(),
+                           [](const std::string & acc, int v) { return acc + std::to_string(v); }) == "615432");
+    ASSERT(*--q->end() == 2);
+
+    DataLoop *r = new DataLoop();
+    *r += 6; *r += 1; *r += 5; *r += 4; *r += 3; *r += 2;
+    ASSERT(*q == *r);
+    ASSERT(*r == *q);
+
+    // splicing loops of either direction into a reversed loop, and back
+    DataLoop a;
+    a += 10; a += 11;
+    q->insert_after(q->handle_at(1), 7);
+    q->splice(a, 2);
+    std::stringstream ss3;
+    ss3 << *q;
+    ASSERT(ss3.str() == "-> 6 <--> 1 <--> 10 <--> 11 <--> 7 <--> 5 <--> 4 <--> 3 <--> 2 <-");
+    DataLoop part = q->split(1, 3);
+    ASSERT(part.is_reversed());
+    std::stringstream ss4;
+    ss4 << part << " " << *q;
+    ASSERT(ss4.str() == "-> 1 <--> 10 <--> 11 <- -> 6 <--> 7 <--> 5 <--> 4 <--> 3 <--> 2 <-");
+    r->splice(part, 1);
+    ASSERT(!r->is_reversed());
+    std::stringstream ss5;
+    ss5 << *r;
+    ASSERT(ss5.str() == "-> 6 <--> 1 <--> 10 <--> 11 <--> 1 <--> 5 <--> 4 <--> 3 <--> 2 <-");
+
+    // making the order physical keeps the order
+    q->materialize_reverse();
+    ASSERT(!q->is_reversed());
+    ASSERT(q->start->next->data == 7);
+    ASSERT(q->start->prev->data == 2);
+    std::stringstream ss6;
+    ss6 << *q;
+    ASSERT(ss6.str() == "-> 6 <--> 7 <--> 5 <--> 4 <--> 3 <--> 2 <-");
+    delete q;
+    delete r;
+
+    // my tests
+    DataLoop *m = new DataLoop();
+    for (int i = 1; i <= 10; i++) {
+      *m += i;
+    }
+    m->reverse();
+    std::vector<int> order = m->eliminate_every(1);
+    int expected[] = {10, 8, 6, 4, 2, 9, 5, 1, 3, 7};
+    ASSERT(std::equal(order.begin(), order.end(), expected));
+    m->reverse();
+    *m += 1;
+    m->reverse();
+    m->reverse();
+    ASSERT(!m->is_reversed());
+    std::stringstream ss7;
+    ss7 << *m;
+    ASSERT(ss7.str() == "-> 1 <-");
+    delete m;
+  }
+
+  /**
+   * \brief A test function for sort, parallel_sort and merge, depends on operator+= and operator<<
+   */
+  static void FunctionSortTest() {
+    DataLoop *q = new DataLoop(4);
+    *q += 2; *q += 5; *q += 1; *q += 3;
+    DataLoop::_Node *five = q->start->next->next;
+    q->sort();
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> 1 <--> 2 <--> 3 <--> 4 <--> 5 <-");
+    ASSERT(q->start->prev == five);          // nodes are relinked, not copied
+    q->sort([](int a, int b) { return a > b; });
+    ASSERT(q->start == five);
+    ASSERT(q->start->next->data == 4);
+
+    // merge takes a reversed sorted loop and empties it
+    q->sort();
+    DataLoop *r = new DataLoop(6);
+    *r += 3; *r += 0;
+    r->reverse();                            // 6 0 3
+    *r ^ 1;                                  // 0 3 6
+    q->merge(*r);
+    std::stringstream ss2;
+    ss2 << *q;
+    ASSERT(ss2.str() == "-> 0 <--> 1 <--> 2 <--> 3 <--> 3 <--> 4 <--> 5 <--> 6 <-");
+    ASSERT(r->length() == 0);
+    ASSERT(q->start->prev->data == 6);
+    delete r;
+    delete q;
+
+    // my tests
+    // parallel_sort matches std::sort, and sorting stays sorted
+    DataLoop p;
+    std::vector<int> expected;
+    unsigned seed = 7;
+    for (int i = 0; i < 70000; i++) {
+      seed = seed * 1103515245 + 12345;
+      int v = static_cast<int>(seed >> 8) - (1 << 22);
+      expected.push_back(v);
+      p += v;
+    }
+    std::sort(expected.begin(), expected.end());
+    p.parallel_sort(std::less<int>(), 3);
+    ASSERT(std::vector<int>(p.begin(), p.end()) == expected);
+    ASSERT(p.start->prev->data == expected.back());
+    p.sort();
+    ASSERT(std::vector<int>(p.begin(), p.end()) == expected);
+
+    // an empty loop merges into an empty loop
+    DataLoop e1, e2;
+    e1.merge(e2);
+    ASSERT(e1.length() == 0);
+    e2 += 1;
+    e1.merge(e2);
+    ASSERT(e1.length() == 1 && e1.start->next == e1.start);
+  }
+
+  /**
+   * \brief A test function for radix_sort and partition_into, depends on operator+= and operator<<
+   */
+  static void FunctionRadixTest() {
+    DataLoop *q = new DataLoop(300);
+    *q += -70000; *q += 5; *q += -1; *q += 65536; *q += 5; *q += 0;
+    DataLoop::_Node *five = q->start->next->next;
+    q->radix_sort();
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> -70000 <--> -1 <--> 0 <--> 5 <--> 5 <--> 300 <--> 65536 <-");
+    ASSERT(q->start->next->next->next == five);  // stable, and nodes are relinked
+    ASSERT(q->start->prev->data == 65536);
+
+    // partition_into by sign keeps the order inside each part
+    std::vector<DataLoop> parts = q->partition_into(2, [](int v) { return static_cast<size_t>(v >= 0); });
+    ASSERT(q->length() == 0);
+    std::stringstream ss2;
+    ss2 << parts[0] << parts[1];
+    ASSERT(ss2.str() == "-> -70000 <--> -1 <-" "-> 0 <--> 5 <--> 5 <--> 300 <--> 65536 <-");
+    ASSERT(parts[1].start->next == five);
+    delete q;
+
+    // my tests
+    // radix_sort matches std::sort on a reversed loop with values of every size
+    DataLoop r;
+    std::vector<int> expected;
+    unsigned seed = 99;
+    for (int i = 0; i < 5000; i++) {
+      seed = seed * 1103515245 + 12345;
+      int v = static_cast<int>(seed) >> (seed % 31);
+      expected.push_back(v);
+      r += v;
+    }
+    r.reverse();
+    r.radix_sort();
+    std::sort(expected.begin(), expected.end());
+    ASSERT(std::vector<int>(r.begin(), r.end()) == expected);
+    ASSERT(!r.is_reversed());
+    ASSERT(r.start->prev->next == r.start);
+
+    // a bad key throws before anything moves, and k of 0 is rejected
+    bool thrown = false;
+    try {
+      r.partition_into(4, [](int v) { return static_cast<size_t>(v & 7); });
+    }
+    catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+    ASSERT(r.length() == 5000);
+    thrown = false;
+    try {
+      r.partition_into(0, [](int) { return static_cast<size_t>(0); });
+    }
+    catch (const std::invalid_argument &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+    DataLoop e;
+    ASSERT(e.partition_into(3, [](int) { return static_cast<size_t>(0); }).size() == 3);
+  }
+
+  /**
+   * \brief A test function for remove_if, unique and stable_partition, depends on operator+= and operator<<
+   */
+  static void FunctionFilterTest() {
+    DataLoop *q = new DataLoop(10);
+    *q += 1; *q += 11; *q += 2; *q += 12;
+    DataLoop::_Node *two = q->start->next->next->next;
+    ASSERT(q->remove_if([](int v) { return v >= 10; }) == 3);
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> 1 <--> 2 <-");
+    ASSERT(q->start->next == two && two->next == q->start);
+
+    *q += 2; *q += 2; *q += 3; *q += 1;
+    ASSERT(q->unique() == 2);
+    std::stringstream ss2;
+    ss2 << *q;
+    ASSERT(ss2.str() == "-> 1 <--> 2 <--> 3 <--> 1 <-");
+
+    *q += 4;
+    ASSERT(q->stable_partition([](int v) { return v % 2 == 1; }) == 3);
+    std::stringstream ss3;
+    ss3 << *q;
+    ASSERT(ss3.str() == "-> 1 <--> 3 <--> 1 <--> 2 <--> 4 <-");
+    ASSERT(q->start->next->next->next == two);
+    ASSERT(q->start->prev->data == 4);
+    delete q;
+
+    // my tests
+    // everything removed, and the start node removed from a reversed loop
+    DataLoop r;
+    for (int i = 0; i < 6; i++) {
+      r += i;
+    }
+    r.reverse(); // 0 5 4 3 2 1
+    ASSERT(r.remove_if([](int v) { return v == 0 || v == 4; }) == 2);
+    std::stringstream ss4;
+    ss4 << r;
+    ASSERT(ss4.str() == "-> 5 <--> 3 <--> 2 <--> 1 <-");
+    ASSERT(r.stable_partition([](int v) { return v < 3; }) == 2);
+    std::stringstream ss5;
+    ss5 << r;
+    ASSERT(ss5.str() == "-> 2 <--> 1 <--> 5 <--> 3 <-");
+    ASSERT(r.remove_if([](int) { return true; }) == 4);
+    ASSERT(r.length() == 0);
+    ASSERT(r.unique() == 0);
+    ASSERT(r.stable_partition([](int) { return true; }) == 0);
+  }
+
+  /**
+   * \brief A test function for LoopView, depends on operator+=, operator^ and operator<<
+   */
+  static void LoopViewTest() {
+    DataLoop *q = new DataLoop(1);
+    *q += 2; *q += 3; *q += 4;
+    DataLoop::LoopView a = q->view();
+    DataLoop::LoopView b = q->view(-1);
+    ASSERT(a == *q);
+    ASSERT(b != *q);
+    std::stringstream ss1;
+    ss1 << b;
+    ASSERT(ss1.str() == "-> 4 <--> 1 <--> 2 <--> 3 <-");
+    b ^ 2;
+    ASSERT(b.start_handle() == q->handle_at(1));
+    ASSERT(std::accumulate(b.begin(), b.end(), 0) == 10);
+    ASSERT(q->start->data == 1);
+
+    // comparing against an equal loop with a different start
+    DataLoop *r = new DataLoop(2);
+    *r += 3; *r += 4; *r += 1;
+    ASSERT(b == *r && *r == b);
+    ASSERT(a != b);
+    a ^ 5;
+    ASSERT(a == b);
+    delete r;
+    delete q;
+
+    // my tests
+    // a view keeps its node when the loop grows or rotates
+    DataLoop s(7);
+    DataLoop::LoopView v = s.view();
+    s += 8; s += 9;
+    s ^ 1;
+    std::stringstream ss2;
+    ss2 << v << " " << s;
+    ASSERT(ss2.str() == "-> 7 <--> 8 <--> 9 <- -> 8 <--> 9 <--> 7 <-");
+    ASSERT(v.length() == 3);
+  }
+
+  /**
+   * \brief A test function for compact
+   */
+  static void FunctionCompactTest() {
+    DataLoop *q = new DataLoop();
+    for (int i = 0; i < 10; i++) {
+      *q += i;
+    }
+    *q ^ 3;
+    q->reverse();
+    std::stringstream before;
+    before << *q;
+    q->compact();
+    std::stringstream after;
+    after << *q;
+    ASSERT(after.str() == before.str());
+    ASSERT(after.str() == "-> 3 <--> 2 <--> 1 <--> 0 <--> 9 <--> 8 <--> 7 <--> 6 <--> 5 <--> 4 <-");
+    ASSERT(q->is_reversed());
+
+    // the nodes lie one after another in the block, in the order of the loop
+    ASSERT(q->ext->blocks.size() == 1);
+    ASSERT(q->start == q->ext->blocks.begin()->second->nodes);
+    bool in_order = true;
+    DataLoop::_Node *cur = q->start;
+    for (int i = 0; i < 10; i++) {
+      in_order = in_order && q->forward(cur) == q->start + (i + 1) % 10 && q->backward(q->forward(cur)) == cur;
+      cur = q->forward(cur);
+    }
+    ASSERT(in_order);
+
+    // nodes of the block are freed in place, and new ones come from the heap
+    ASSERT(q->remove_at_offset(1) == 2);
+    *q += 42;
+    ASSERT(!q->ext->blocks.begin()->second->owns(q->backward(q->start)));
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> 1 <--> 0 <--> 9 <--> 8 <--> 7 <--> 6 <--> 5 <--> 4 <--> 3 <--> 42 <-");
+
+    // a split shares the block, which outlives the loop it came from
+    DataLoop part = q->split(2, 3);
+    ASSERT(part.ext->blocks.size() == 1);
+    ASSERT(part.ext->blocks.begin()->second == q->ext->blocks.begin()->second);
+    delete q;
+    std::stringstream ss2;
+    ss2 << part;
+    ASSERT(ss2.str() == "-> 9 <--> 8 <--> 7 <-");
+
+    // a splice hands the block over with the nodes
+    DataLoop r(100);
+    r.splice(part, 1);
+    ASSERT((!part.ext || part.ext->blocks.empty()));
+    ASSERT(r.ext->blocks.size() == 1);
+    ASSERT(r.ext->blocks.begin()->second.use_count() == 1);
+    std::stringstream ss3;
+    ss3 << r;
+    ASSERT(ss3.str() == "-> 100 <--> 9 <--> 8 <--> 7 <-");
+
+    // compacting again moves everything into a new block and lets the old one go
+    r.compact();
+    ASSERT(r.ext->blocks.size() == 1);
+    ASSERT(r.start == r.ext->blocks.begin()->second->nodes);
+    ASSERT(r.length() == 4);
+
+    // my tests
+    DataLoop empty;
+    empty.compact();
+    ASSERT((!empty.ext || empty.ext->blocks.empty()));
+    ASSERT(empty.start == nullptr);
+
+    DataLoop one(7);
+    one.compact();
+    ASSERT(one.start->next == one.start);
+    ASSERT(one.start->prev == one.start);
+    DataLoop moved = std::move(one);
+    ASSERT(moved.ext->blocks.size() == 1);
+    ASSERT((!one.ext || one.ext->blocks.empty()));
+    std::vector<DataLoop> parts = moved.partition_into(2, [](int) { return 1; });
+    ASSERT(parts[1].ext->blocks.size() == 1);
+    ASSERT((!moved.ext || moved.ext->blocks.empty()));
+    ASSERT(parts[1].length() == 1);
+
+    // the block goes when its last node does, and the loop it was split from drops the husk
+    DataLoop s;
+    for (int i = 0; i < 4; i++) {
+      s += i;
+    }
+    s.compact();
+    DataLoop half = s.split(0, 2);
+    std::weak_ptr<DataLoop::_Block> shared = s.ext->blocks.begin()->second;
+    half.clear();
+    ASSERT(half.ext->blocks.empty());
+    ASSERT(!shared.expired());
+    ASSERT(!shared.lock()->freed);
+    s.remove_at_offset(0);
+    s.remove_at_offset(0);
+    ASSERT(s.ext->blocks.empty());
+    ASSERT(shared.expired());
+
+    DataLoop t;
+    for (int i = 0; i < 4; i++) {
+      t += i;
+    }
+    t.compact();
+    DataLoop tail = t.split(2, 2);
+    shared = t.ext->blocks.begin()->second;
+    t.remove_at_offset(0);
+    t.remove_at_offset(0);
+    tail.remove_at_offset(0);
+    tail.remove_at_offset(0);
+    ASSERT(t.ext->blocks.size() == 1);
+    ASSERT(shared.lock()->freed);
+    t += 5;
+    t.compact();
+    ASSERT(t.ext->blocks.size() == 1);
+    ASSERT(shared.expired());
+
+    // a compaction that is begun again drops its block if no node was moved into it
+    DataLoop u;
+    for (int i = 0; i < 4; i++) {
+      u += i;
+    }
+    ASSERT(!u.compact_step(0));
+    ASSERT(u.ext->blocks.size() == 1);
+    u += 4;
+    ASSERT(!u.compact_step(1));
+    ASSERT(u.ext->blocks.size() == 1);
+    ASSERT(u.ext->pending->size == 5);
+    u += 5;
+    ASSERT(!u.compact_step(0));
+    ASSERT(u.ext->blocks.size() == 2);
+    ASSERT(u.compact_step(6));
+    ASSERT(u.ext->blocks.size() == 1);
+  }
+
+  /**
+   * \brief A test function for memory_usage and the registry
+   */
+  static void FunctionMemoryUsageTest() {
+    ASSERT(heap_block_bytes(1) == 32);
+    ASSERT(heap_block_bytes(24) == 32);
+    ASSERT(heap_block_bytes(40) == 48);
+    ASSERT(heap_block_bytes(100) == 112);
+
+    DataLoop *q = new DataLoop();
+    ASSERT(q->memory_usage().total() == 0);
+    for (int i = 0; i < 10; i++) {
+      *q += i;
+    }
+    size_t node = sizeof(DataLoop::_Node);
+    LoopMemory m1 = q->memory_usage();
+    ASSERT(m1.node_bytes == 10 * node);
+    ASSERT(m1.overhead_bytes == 10 * (heap_block_bytes(node) - node));
+    ASSERT(m1.value_bytes == 0);
+    ASSERT(m1.slack_bytes == 0);
+    ASSERT(m1.total() == 10 * heap_block_bytes(node));
+
+    // a compacted loop pays the overhead once, and freed nodes leave slack in the block
+    q->compact();
+    LoopMemory m2 = q->memory_usage();
+    ASSERT(m2.node_bytes == 10 * node);
+    ASSERT(m2.overhead_bytes == heap_block_bytes(10 * node) - 10 * node);
+    ASSERT(m2.slack_bytes == 0);
+    q->remove_at_offset(0);
+    q->remove_at_offset(0);
+    *q += 50;
+    LoopMemory m3 = q->memory_usage();
+    ASSERT(m3.node_bytes == 9 * node);
+    ASSERT(m3.slack_bytes == 2 * node);
+    ASSERT(m3.overhead_bytes == m2.overhead_bytes + heap_block_bytes(node) - node);
+
+    // a shared block is split between the loops sharing it
+    DataLoop part = q->split(0, 4);
+    ASSERT(part.memory_usage().slack_bytes == node);
+    ASSERT(q->memory_usage().slack_bytes == node);
+
+    // the registry counts the nodes of every live loop as they come and go
+    LoopMemory before = LoopRegistry::total();
+    {
+      DataLoop r;
+      for (int i = 0; i < 5; i++) {
+        r += i;
+      }
+      LoopMemory during = LoopRegistry::total();
+      ASSERT(during.node_bytes == before.node_bytes + 5 * node);
+      ASSERT(during.total() == before.total() + r.memory_usage().total());
+    }
+    ASSERT(LoopRegistry::total().total() == before.total());
+    delete q;
+    ASSERT(LoopRegistry::total().node_bytes == part.memory_usage().node_bytes);
+
+    // my tests
+    DataLoop copy(part);
+    DataLoop moved(std::move(copy));
+    ASSERT(LoopRegistry::total().node_bytes == 2 * part.memory_usage().node_bytes);
+    ASSERT(moved.memory_usage().overhead_bytes == moved.length() * (heap_block_bytes(node) - node));
+    ASSERT(copy.memory_usage().total() == 0);
+  }
+
+  /**
+   * \brief A test function for clear_incremental and defer_destroy
+   */
+  static void FunctionClearIncrementalTest() {
+    DataLoop q;
+    for (int i = 0; i < 10; i++) {
+      q += i;
+    }
+    size_t node = sizeof(DataLoop::_Node);
+
+    // the loop is empty after the first call, and the nodes are freed a few at a time
+    ASSERT(!q.clear_incremental(4));
+    ASSERT(q.length() == 0);
+    ASSERT(q.start == nullptr);
+    ASSERT(q.ext->dying->count == 6);
+    ASSERT(q.memory_usage().node_bytes == 6 * node);
+    ASSERT(!q.clear_incremental(4));
+    ASSERT(q.ext->dying->count == 2);
+
+    // the loop can be used again, and clearing it again adds to the nodes put aside
+    q += 20;
+    q += 21;
+    std::stringstream ss1;
+    ss1 << q;
+    ASSERT(ss1.str() == "-> 20 <--> 21 <-");
+    ASSERT(!q.clear_incremental(3));
+    ASSERT(q.ext->dying->count == 1);
+    ASSERT(q.clear_incremental(3));
+    ASSERT((!q.ext || q.ext->dying == nullptr));
+    ASSERT(q.clear_incremental(3));
+    ASSERT(q.memory_usage().total() == 0);
+
+    // nodes of a compacted block are freed in place, and the block goes with the last of them
+    for (int i = 0; i < 6; i++) {
+      q += i;
+    }
+    q.compact();
+    std::weak_ptr<DataLoop::_Block> block = q.ext->blocks.begin()->second;
+    ASSERT(!q.clear_incremental(2));
+    ASSERT((!q.ext || q.ext->blocks.empty()));
+    ASSERT(block.lock()->live == 4);
+    ASSERT(q.clear_incremental(10));
+    ASSERT(block.expired());
+
+    // a deferred loop is freed on the reclaimer thread
+    DataLoop *r = new DataLoop();
+    for (int i = 0; i < 1000; i++) {
+      *r += i;
+    }
+    r->compact();
+    block = r->ext->blocks.begin()->second;
+    for (int i = 0; i < 10; i++) {
+      *r += i;
+    }
+    r->clear_incremental(5);
+    r->defer_destroy();
+    ASSERT(r->length() == 0);
+    ASSERT((!r->ext || r->ext->dying == nullptr));
+    delete r;
+    LoopReclaimer::drain();
+    ASSERT(LoopReclaimer::pending() == 0);
+    ASSERT(block.expired());
+
+    // my tests
+    DataLoop empty;
+    ASSERT(empty.clear_incremental(0));
+    empty.defer_destroy();
+    ASSERT(LoopReclaimer::pending() == 0);
+
+    DataLoop one(5);
+    ASSERT(!one.clear_incremental(0));
+    ASSERT(one.ext->dying->count == 1);
+    one += 6;
+    one.defer_destroy();
+    LoopReclaimer::drain();
+    ASSERT(one.length() == 0);
+    ASSERT((!one.ext || one.ext->dying == nullptr));
+  }
+
 };
 
 // call our test functions in the main
@@ -605,6 +1440,18 @@ int main(int, char* argv[]) {
   DataLoopTest::OperatorShiftTest();
   DataLoopTest::FunctionLengthTest();
   DataLoopTest::FunctionSpliceTest(); 
+  DataLoopTest::FunctionEliminateTest();
+  DataLoopTest::FunctionHandleTest();
+  DataLoopTest::FunctionSplitTest();
+  DataLoopTest::FunctionSpliceManyTest();
+  DataLoopTest::FunctionReverseTest();
+  DataLoopTest::FunctionSortTest();
+  DataLoopTest::FunctionRadixTest();
+  DataLoopTest::FunctionFilterTest();
+  DataLoopTest::LoopViewTest();
+  DataLoopTest::FunctionCompactTest();
+  DataLoopTest::FunctionMemoryUsageTest();
+  DataLoopTest::FunctionClearIncrementalTest();
   
   return 0;
 }
@@ -0,0 +1,223 @@
+#ifndef __INTRUSIVEDATALOOP_H__
+#define __INTRUSIVEDATALOOP_H__
+
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * \struct DataLoopHook
+ * \brief The links an object embeds to be held by an IntrusiveDataLoop
+ *
+ * \detail Both pointers are nullptr while the object is in no loop. An object can be in one loop per hook it embeds.
+ */
+template<typename T>
+struct DataLoopHook {
+  T *next = nullptr;  ///< the next object in the loop
+  T *prev = nullptr;  ///< the previous object in the loop
+
+  /// true while the object is in a loop through this hook
+  bool linked() const { return next != nullptr; }
+};
+
+/**
+ * \class IntrusiveDataLoop
+ * \brief A dataloop of objects that live in their own storage and are linked through a DataLoopHook they embed
+ *
+ * \detail The loop allocates nothing: adding an object writes its hook, and removing one clears it, so objects that already exist elsewhere can be kept in a loop without the extra allocation and indirection of a TDataLoop<T *>. The loop does not own the objects. They must stay in place while linked, and an object must be taken out of the loop, or the loop cleared or destroyed, before the object is destroyed. Values are compared with operator== and printed with operator<< of T, in the same format as DataLoop.
+ *
+ * \tparam T The type of the objects
+ *
+ * \tparam Hook The member of T that holds the links, as in IntrusiveDataLoop<Task, &Task::hook>
+ */
+template<typename T, DataLoopHook<T> T::*Hook>
+class IntrusiveDataLoop {
+    public:
+  /**
+   * \class basic_iterator
+   * \brief A bidirectional iterator that visits each object once, beginning at start
+   *
+   * \detail Like the DataLoop iterator it counts its steps from start, and end() is start after count steps.
+   */
+  template<bool Const>
+  class basic_iterator {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T, T>::type * pointer;
+    typedef typename std::conditional<Const, const T, T>::type & reference;
+
+    basic_iterator() : cur(nullptr), steps(0) { }
+
+    /// a const_iterator can be made from an iterator
+    template<bool C = Const, typename = typename std::enable_if<C>::type>
+    basic_iterator(const basic_iterator<false> & it) : cur(it.cur), steps(it.steps) { }
+
+    reference operator*() const { return *cur; }
+    pointer operator->() const { return cur; }
+
+    basic_iterator & operator++() { cur = ((*cur).*Hook).next; steps++; return *this; }
+    basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; }
+    basic_iterator & operator--() { cur = ((*cur).*Hook).prev; steps--; return *this; }
+    basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; }
+
+    bool operator==(const basic_iterator & rhs) const { return steps == rhs.steps; }
+    bool operator!=(const basic_iterator & rhs) const { return !(*this == rhs); }
+
+  private:
+    friend class IntrusiveDataLoop;
+    friend class basic_iterator<!Const>;
+    basic_iterator(T * c, size_t s) : cur(c), steps(s) { }
+
+    T *cur;        ///< the current object
+    size_t steps;  ///< the number of steps taken from start
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  /**
+   * \brief The default constructor
+   *
+   * \detail Creates an empty IntrusiveDataLoop
+   */
+  IntrusiveDataLoop();
+
+  /**
+   * \brief An IntrusiveDataLoop cannot be copied, since an object can be in only one loop through its hook
+   */
+  IntrusiveDataLoop(const IntrusiveDataLoop &) = delete;
+  IntrusiveDataLoop & operator=(const IntrusiveDataLoop &) = delete;
+
+  /**
+   * \brief The move constructor
+   *
+   * \detail Takes over the objects of rhs and leaves rhs empty
+   */
+  IntrusiveDataLoop(IntrusiveDataLoop && rhs);
+
+  /**
+   * \brief Overloaded move operator= to hand the objects of an IntrusiveDataLoop to another IntrusiveDataLoop
+   *
+   * \detail The objects of *this are taken out of it first.
+   */
+  IntrusiveDataLoop & operator=(IntrusiveDataLoop && rhs);
+
+  /**
+   * \brief Helper function called in destructor
+   *
+   * \detail Takes every object out of the loop, clearing its hook, and leaves the IntrusiveDataLoop empty. The objects themselves are untouched.
+   */
+  void clear();
+
+  /**
+   * \brief The destructor
+   */
+  ~IntrusiveDataLoop();
+
+
+  /**
+   * \brief Overloaded operator== to check if two IntrusiveDataLoops hold equal values in the same order from start
+   *
+   * \detail The objects are compared with operator== of T, so two loops of different objects can be equal.
+   */
+  bool operator==(const IntrusiveDataLoop & rhs) const;
+
+
+  /**
+   * \brief Overloaded operator+= to add an object to the end of this IntrusiveDataLoop
+   *
+   * \detail The object is linked before start in O(1) without allocating.
+   *
+   * \throw std::invalid_argument if the object is already in a loop through this hook
+   */
+  IntrusiveDataLoop & operator+=(T & obj);
+
+
+  /**
+   * \brief Overloaded operator^ to shift the start position forward for a positive offset and backward for a negative offset
+   */
+  IntrusiveDataLoop & operator^(int offset);
+
+
+  /**
+   * \brief Function splice to insert an entire IntrusiveDataLoop into this one
+   *
+   * \detail As DataLoop::splice, position 0 inserts rhs before start and makes the start of rhs the new start, and position n inserts rhs after object n, looping around as needed. The objects of rhs are relinked, changing four links, and rhs is left empty.
+   *
+   * \param[in] rhs A reference to an IntrusiveDataLoop object to insert into *this
+   *
+   * \param[in] pos The insertion position
+   *
+   * \return A reference to the updated IntrusiveDataLoop object
+   */
+  IntrusiveDataLoop & splice(IntrusiveDataLoop & rhs, size_t pos);
+
+
+  /**
+   * \brief Function erase to take an object out of the loop
+   *
+   * \detail O(1) without a search, since the object carries its links. If it is the start object, start moves on to the next one. The object must be in this loop.
+   *
+   * \param[in] obj The object to take out
+   *
+   * \throw std::invalid_argument if the object is in no loop through this hook
+   */
+  void erase(T & obj);
+
+
+  /**
+   * \brief Function remove_at_offset to shift the start position by offset and take that object out of the loop
+   *
+   * \detail As DataLoop::remove_at_offset, start moves on to the object after the one taken out.
+   *
+   * \return The object taken out
+   *
+   * \throw std::out_of_range if the IntrusiveDataLoop is empty
+   */
+  T & remove_at_offset(int offset);
+
+
+  /**
+   * \brief Function length to report the number of objects in *this IntrusiveDataLoop
+   */
+  int length() const { return static_cast<int>(count); }
+
+
+  /**
+   * \brief Functions begin and end to iterate over the IntrusiveDataLoop from the start object
+   */
+  iterator begin() { return iterator(start, 0); }
+  iterator end() { return iterator(start, count); }
+  const_iterator begin() const { return const_iterator(start, 0); }
+  const_iterator end() const { return const_iterator(start, count); }
+
+
+  /**
+   * \brief Overloaded output stream operator<< to print the IntrusiveDataLoop
+   *
+   * \detail Prints "-> data1 <--> data2 <--> ... <--> datax <-" where data1 is the start object, or ">no values<" if the IntrusiveDataLoop is empty.
+   */
+  template<typename U, DataLoopHook<U> U::*H>
+  friend std::ostream & operator<<(std::ostream & os, const IntrusiveDataLoop<U, H> & dl);
+
+private:
+  /// friend IntrusiveDataLoopTest struct to allow the test struct access to the private data
+  friend struct IntrusiveDataLoopTest;
+
+  /// the links of obj
+  static DataLoopHook<T> & hook(T & obj) { return obj.*Hook; }
+
+  /// the object shifted offset places from start, walking the shorter way round
+  T * at_offset(long offset) const;
+
+  T *start;      ///< the start object
+  size_t count;  ///< the number of objects in the loop
+};
+
+#include "IntrusiveDataLoop.inc"
+#endif // __INTRUSIVEDATALOOP_H__
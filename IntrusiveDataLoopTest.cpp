@@ -0,0 +1,378 @@
+#include "IntrusiveDataLoop.h"
+#include "TDataLoop.h"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+using std::cout;
+using std::endl;
+using std::string;
+
+#ifndef ASSERT
+#include <csignal>  // signal handler 
+#include <cstring>  // memset
+
+char programName[128];
+
+void segFaultHandler(int, siginfo_t*, void* context) {
+  char cmdbuffer[1024];
+  char resultbuffer[128];
+#ifdef __APPLE__
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext->__ss.__rip);
+#else
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+  std::string result = "";
+  FILE* pipe = popen(cmdbuffer, "r");
+  if (!pipe) throw std::runtime_error("popen() failed!");
+  try {
+    while (fgets(resultbuffer, sizeof resultbuffer, pipe) != NULL) {
+      result += resultbuffer;
+    }
+  } catch (...) {
+    pclose(pipe);
+    throw;
+  }
+  pclose(pipe);
+  cout << "Segmentation fault occured in " << result;
+#ifdef __APPLE__
+  ((ucontext_t*)context)->uc_mcontext->__ss.__rip += 2;  // skip the seg fault
+#else
+  ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP] += 2;  // skip the seg fault
+#endif
+}
+
+#define ASSERT(cond) if (!(cond)) { \
+    cout << "failed ASSERT " << #cond << " at line " << __LINE__ << endl; \
+  } else { \
+    cout << __func__ << " - (" << #cond << ")" << " passed!" << endl; \
+  }
+#endif
+
+/// the number of calls to operator new so far, to show that the intrusive loop allocates nothing
+static size_t allocations = 0;
+
+void * operator new(size_t size) {
+  allocations++;
+  void *p = std::malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, size_t) noexcept { std::free(p); }
+
+/**
+ * \struct Task
+ * \brief A schedulable object that can be in two loops at once, one through each hook
+ */
+struct Task {
+  int id;
+  DataLoopHook<Task> hook;   ///< the links of the run queue
+  DataLoopHook<Task> ready;  ///< the links of the ready list
+
+  explicit Task(int i = 0) : id(i) { }
+  bool operator==(const Task & rhs) const { return id == rhs.id; }
+};
+
+std::ostream & operator<<(std::ostream & os, const Task & t) {
+  return os << t.id;
+}
+
+/**
+ * \struct IntrusiveDataLoopTest
+ * \defgroup IntrusiveDataLoopTest
+ * \brief Test cases for the IntrusiveDataLoop class
+ */
+struct IntrusiveDataLoopTest {
+  // aliases
+  using Queue = IntrusiveDataLoop<Task, &Task::hook>;
+  using Ready = IntrusiveDataLoop<Task, &Task::ready>;
+
+  /// prints any printable object, for comparing the formats of two kinds of loop
+  template<typename Loop>
+  static string text(const Loop & dl) {
+    std::stringstream ss;
+    ss << dl;
+    return ss.str();
+  }
+
+  /**
+   * \brief A test function for the constructors, clear and the destructor
+   */
+  static void ConstructorTest() {
+    Queue empty;
+    ASSERT(empty.start == nullptr);
+    ASSERT(empty.length() == 0);
+    ASSERT(text(empty) == ">no values<");
+
+    Task tasks[3] = {Task(1), Task(2), Task(3)};
+    {
+      Queue q;
+      for (Task & t : tasks) {
+        q += t;
+      }
+      ASSERT(tasks[0].hook.linked());
+      Queue moved(std::move(q));
+      ASSERT(q.length() == 0);
+      ASSERT(moved.length() == 3);
+      ASSERT(text(moved) == "-> 1 <--> 2 <--> 3 <-");
+    }
+    // the destructor unlinks the objects and leaves them in place
+    ASSERT(!tasks[0].hook.linked());
+    ASSERT(tasks[2].hook.prev == nullptr);
+    ASSERT(tasks[1].id == 2);
+
+    // my tests
+    Queue a;
+    Queue b;
+    a += tasks[0];
+    b += tasks[1];
+    a = std::move(b);
+    ASSERT(!tasks[0].hook.linked());
+    ASSERT(text(a) == "-> 2 <-");
+    a.clear();
+    ASSERT(!tasks[1].hook.linked());
+    ASSERT(a.length() == 0);
+  }
+
+  /**
+   * \brief A test function for operator+=, operator<< and the absence of allocations
+   */
+  static void OperatorPlusGetsTest() {
+    Task tasks[100];
+    for (int i = 0; i < 100; i++) {
+      tasks[i].id = i;
+    }
+
+    // linking, shifting, splicing and unlinking allocate nothing
+    Queue q;
+    Queue r;
+    size_t before = allocations;
+    for (int i = 0; i < 90; i++) {
+      q += tasks[i];
+    }
+    for (int i = 90; i < 100; i++) {
+      r += tasks[i];
+    }
+    q ^ 45;
+    q.splice(r, 7);
+    q.erase(tasks[3]);
+    q.remove_at_offset(-2);
+    ASSERT(allocations == before);
+    ASSERT(q.length() == 98);
+
+    Queue s;
+    Task lone(0);
+    s += lone;
+    ASSERT(text(s) == "-> 0 <-");
+    ASSERT(s.start->hook.next == s.start);
+    ASSERT(s.start->hook.prev == s.start);
+
+    // an object already in a loop cannot be added again through the same hook
+    bool threw = false;
+    try {
+      s += tasks[1];
+    }
+    catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT(threw);
+    ASSERT(s.length() == 1);
+
+    // my tests
+    Task a(7);
+    Task b(8);
+    Queue t;
+    t += a;
+    t += b;
+    ASSERT(text(t) == "-> 7 <--> 8 <-");
+    Queue::iterator it = t.begin();
+    it->id = 9;
+    Queue::const_iterator cit = it;
+    ASSERT(cit->id == 9);
+    ASSERT(++cit != t.end());
+    ASSERT(++cit == t.end());
+    ASSERT((--cit)->id == 8);
+  }
+
+  /**
+   * \brief A test function for operator^
+   */
+  static void OperatorShiftTest() {
+    Task tasks[5] = {Task(1), Task(2), Task(3), Task(4), Task(5)};
+    Queue q;
+    TDataLoop<int> t;
+    for (Task & task : tasks) {
+      q += task;
+      t += task.id;
+    }
+
+    int offsets[] = {2, -3, 11, -12, 0, 4, -1, 8};
+    bool same = true;
+    for (int offset : offsets) {
+      q ^ offset;
+      t ^ offset;
+      same = same && text(q) == text(t);
+    }
+    ASSERT(same);
+
+    // my tests
+    Queue empty;
+    empty ^ 3;
+    ASSERT(empty.length() == 0);
+  }
+
+  /**
+   * \brief A test function for splice
+   */
+  static void FunctionSpliceTest() {
+    // the same positions as DataLoop, including those past the end
+    bool same = true;
+    for (size_t pos = 0; pos < 9; pos++) {
+      Task tasks[7] = {Task(1), Task(2), Task(3), Task(4), Task(7), Task(8), Task(9)};
+      Queue a;
+      Queue b;
+      TDataLoop<int> ta;
+      TDataLoop<int> tb;
+      for (int i = 0; i < 4; i++) {
+        a += tasks[i];
+        ta += tasks[i].id;
+      }
+      for (int i = 4; i < 7; i++) {
+        b += tasks[i];
+        tb += tasks[i].id;
+      }
+      a.splice(b, pos);
+      ta.splice(tb, pos);
+      same = same && text(a) == text(ta) && b.length() == 0 && b.start == nullptr;
+    }
+    ASSERT(same);
+
+    // an empty loop takes over the objects of rhs
+    Task tasks[3] = {Task(1), Task(2), Task(3)};
+    Queue a;
+    for (Task & t : tasks) {
+      a += t;
+    }
+    Queue empty;
+    empty.splice(a, 2);
+    ASSERT(text(empty) == "-> 1 <--> 2 <--> 3 <-");
+    ASSERT(a.length() == 0);
+
+    // my tests
+    empty.splice(empty, 1);
+    empty.splice(a, 0);
+    ASSERT(empty.length() == 3);
+    ASSERT(tasks[2].hook.next == &tasks[0]);
+  }
+
+  /**
+   * \brief A test function for erase and remove_at_offset
+   */
+  static void FunctionEraseTest() {
+    Task tasks[6] = {Task(1), Task(2), Task(3), Task(4), Task(5), Task(6)};
+    Queue q;
+    for (Task & t : tasks) {
+      q += t;
+    }
+
+    // erasing the start moves start on, and the object can be added again
+    q.erase(tasks[0]);
+    ASSERT(!tasks[0].hook.linked());
+    ASSERT(text(q) == "-> 2 <--> 3 <--> 4 <--> 5 <--> 6 <-");
+    q += tasks[0];
+    ASSERT(text(q) == "-> 2 <--> 3 <--> 4 <--> 5 <--> 6 <--> 1 <-");
+
+    Task & removed = q.remove_at_offset(2);
+    ASSERT(&removed == &tasks[3]);
+    ASSERT(text(q) == "-> 5 <--> 6 <--> 1 <--> 2 <--> 3 <-");
+
+    // an object is in one loop per hook, independently
+    Ready ready;
+    ready += tasks[4];
+    ready += tasks[1];
+    q.erase(tasks[1]);
+    ASSERT(text(ready) == "-> 5 <--> 2 <-");
+    ASSERT(text(q) == "-> 5 <--> 6 <--> 1 <--> 3 <-");
+
+    bool threw = false;
+    try {
+      q.erase(tasks[1]);
+    }
+    catch (const std::invalid_argument &) {
+      threw = true;
+    }
+    ASSERT(threw);
+
+    threw = false;
+    try {
+      Queue().remove_at_offset(0);
+    }
+    catch (const std::out_of_range &) {
+      threw = true;
+    }
+    ASSERT(threw);
+
+    // my tests
+    Queue one;
+    Task t(42);
+    one += t;
+    ASSERT(one.remove_at_offset(-5).id == 42);
+    ASSERT(one.start == nullptr);
+    ASSERT(!t.hook.linked());
+  }
+
+  /**
+   * \brief A test function for operator==
+   */
+  static void OperatorEqualTest() {
+    // objects are compared by value, not by address
+    Task a[3] = {Task(1), Task(2), Task(3)};
+    Task b[3] = {Task(1), Task(2), Task(3)};
+    Queue qa;
+    Queue qb;
+    for (int i = 0; i < 3; i++) {
+      qa += a[i];
+      qb += b[i];
+    }
+    ASSERT(qa == qb);
+    qb ^ 1;
+    ASSERT(!(qa == qb));
+    qb ^ -1;
+    b[2].id = 4;
+    ASSERT(!(qa == qb));
+
+    // my tests
+    Queue e1;
+    Queue e2;
+    ASSERT(e1 == e2);
+    ASSERT(!(e1 == qa));
+  }
+};
+
+int main(int, char* argv[]) {
+  cout << "Testing IntrusiveDataLoop" << endl;
+  // register a seg fault handler
+  sprintf(programName, "%s", argv[0]);
+  struct sigaction signalAction;
+  memset(&signalAction, 0, sizeof(struct sigaction));
+  signalAction.sa_flags = SA_SIGINFO;
+  signalAction.sa_sigaction = segFaultHandler;
+  sigaction(SIGSEGV, &signalAction, NULL);
+
+  IntrusiveDataLoopTest::ConstructorTest();   // Task
+  IntrusiveDataLoopTest::OperatorPlusGetsTest();   // Task
+  IntrusiveDataLoopTest::OperatorShiftTest();   // Task, int
+  IntrusiveDataLoopTest::FunctionSpliceTest();   // Task, int
+  IntrusiveDataLoopTest::FunctionEraseTest();   // Task
+  IntrusiveDataLoopTest::OperatorEqualTest();   // Task
+  
+  return 0;
+}
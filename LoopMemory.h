@@ -0,0 +1,224 @@
+#ifndef __LOOPMEMORY_H__
+#define __LOOPMEMORY_H__
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \struct LoopMemory
+ * \brief The heap footprint of a loop, as reported by memory_usage
+ *
+ * \detail Allocator overhead is an estimate for a glibc-style allocator, which rounds each request plus an 8-byte header up to a multiple of 16 bytes, and at least 32.
+ */
+struct LoopMemory {
+  size_t node_bytes = 0;      ///< the bytes of the nodes themselves, wherever they are stored
+  size_t overhead_bytes = 0;  ///< the estimated allocator rounding and headers for the nodes, plus any index
+  size_t value_bytes = 0;     ///< the heap bytes owned by the values, as reported by owned_bytes
+  size_t slack_bytes = 0;     ///< the bytes reserved for nodes but not in use, such as free inline slots and unused parts of compacted blocks
+
+  /// the sum of every part
+  size_t total() const { return node_bytes + overhead_bytes + value_bytes + slack_bytes; }
+
+  /// adds every part of rhs to this
+  LoopMemory & operator+=(const LoopMemory & rhs) {
+    node_bytes += rhs.node_bytes;
+    overhead_bytes += rhs.overhead_bytes;
+    value_bytes += rhs.value_bytes;
+    slack_bytes += rhs.slack_bytes;
+    return *this;
+  }
+};
+
+
+/**
+ * \brief Estimates the bytes the allocator takes to satisfy a request for n bytes
+ */
+inline size_t heap_block_bytes(size_t n) {
+  size_t chunk = (n + 8 + 15) / 16 * 16;
+  return chunk < 32 ? 32 : chunk;
+}
+
+
+/**
+ * \brief The heap bytes owned by a value, beyond the value itself
+ *
+ * \detail This is the customization point memory_usage calls for each value. It is 0 unless an overload says otherwise. Overloads are provided for std::string, std::vector and std::pair; for another type, declare size_t owned_bytes(const Type &) in the namespace of the type, or before DataLoop.h or TDataLoop.h is included.
+ */
+template<typename T>
+size_t owned_bytes(const T &) { return 0; }
+
+/// a std::string owns its buffer once it outgrows the small string buffer
+inline size_t owned_bytes(const std::string & value) {
+  return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+}
+
+template<typename A, typename B>
+size_t owned_bytes(const std::pair<A, B> & value);
+
+/// a std::vector owns its buffer and whatever its elements own
+template<typename U, typename Alloc>
+size_t owned_bytes(const std::vector<U, Alloc> & value) {
+  size_t bytes = value.capacity() * sizeof(U);
+  for (size_t i = 0; i < value.size(); i++) {
+    bytes += owned_bytes(value[i]);
+  }
+  return bytes;
+}
+
+/// a std::pair owns what its members own
+template<typename A, typename B>
+size_t owned_bytes(const std::pair<A, B> & value) {
+  return owned_bytes(value.first) + owned_bytes(value.second);
+}
+
+
+/**
+ * \class LoopRegistry
+ * \brief Process-wide counters of the heap memory held by the nodes of every DataLoop and TDataLoop, for exporting memory metrics
+ *
+ * \detail Loops report each heap node and compacted block as they allocate and free it, so total() never walks a loop and may be called from any thread while loops are being changed. The counts go to counters kept per thread and written only by their own thread, without locking; a thread takes the mutex once, the first time it reports, and again when it exits, when its counts are kept. Only heap memory is counted: nodes in the inline slots are part of the loop object, and the heap bytes owned by the values, which can change without the loop seeing it, are left to memory_usage. The hash index is not counted either.
+ */
+class LoopRegistry {
+public:
+  /**
+   * \brief Function total to sum the heap memory of the nodes of every loop
+   *
+   * \detail node_bytes counts the nodes on the heap and in compacted blocks, overhead_bytes the estimated allocator rounding of both, and slack_bytes the room in compacted blocks not holding a node. value_bytes is always 0. A count read while another thread is changing a loop may be a few nodes behind.
+   */
+  static LoopMemory total() {
+    std::lock_guard<std::mutex> lock(mutex());
+    long long node = gone().node;
+    long long overhead = gone().overhead;
+    long long slack = gone().slack;
+    for (counters *c = head(); c; c = c->next) {
+      node += c->node.load(std::memory_order_relaxed);
+      overhead += c->overhead.load(std::memory_order_relaxed);
+      slack += c->slack.load(std::memory_order_relaxed);
+    }
+    LoopMemory sum;
+    sum.node_bytes = node > 0 ? static_cast<size_t>(node) : 0;
+    sum.overhead_bytes = overhead > 0 ? static_cast<size_t>(overhead) : 0;
+    sum.slack_bytes = slack > 0 ? static_cast<size_t>(slack) : 0;
+    return sum;
+  }
+
+
+  /// counts a node of size bytes allocated on its own on the heap
+  static void heap_node(size_t size) {
+    counters & c = mine();
+    c.add(c.node, size);
+    c.add(c.overhead, heap_block_bytes(size) - size);
+  }
+
+  /// uncounts a node of size bytes allocated on its own on the heap
+  static void heap_node_freed(size_t size) {
+    counters & c = mine();
+    c.add(c.node, -static_cast<long long>(size));
+    c.add(c.overhead, -static_cast<long long>(heap_block_bytes(size) - size));
+  }
+
+  /// counts an empty block of size bytes, all of it slack
+  static void block(size_t size) {
+    counters & c = mine();
+    c.add(c.slack, size);
+    c.add(c.overhead, heap_block_bytes(size) - size);
+  }
+
+  /// uncounts an empty block of size bytes
+  static void block_freed(size_t size) {
+    counters & c = mine();
+    c.add(c.slack, -static_cast<long long>(size));
+    c.add(c.overhead, -static_cast<long long>(heap_block_bytes(size) - size));
+  }
+
+  /// counts n nodes of size bytes each constructed in a block, or uncounts them if n is negative
+  static void block_nodes(long long n, size_t size) {
+    counters & c = mine();
+    long long bytes = n * static_cast<long long>(size);
+    c.add(c.node, bytes);
+    c.add(c.slack, -bytes);
+  }
+
+private:
+  /**
+   * \struct counters
+   * \brief The bytes counted by one thread, which may be negative when it frees nodes another thread allocated
+   */
+  struct counters {
+    std::atomic<long long> node{0};      ///< node bytes
+    std::atomic<long long> overhead{0};  ///< allocator overhead bytes
+    std::atomic<long long> slack{0};     ///< unused block bytes
+    counters *next = nullptr;            ///< the counters of another thread
+
+    /// only the owning thread writes, so a plain load and store is enough
+    void add(std::atomic<long long> & counter, long long bytes) {
+      counter.store(counter.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+    }
+  };
+
+  /**
+   * \struct totals
+   * \brief The bytes counted by threads that have exited
+   */
+  struct totals {
+    long long node = 0;
+    long long overhead = 0;
+    long long slack = 0;
+  };
+
+  /**
+   * \struct membership
+   * \brief Lists the counters of a thread from its first report until it exits, then keeps its counts
+   */
+  struct membership {
+    counters c;
+
+    membership() {
+      std::lock_guard<std::mutex> lock(mutex());
+      c.next = head();
+      head() = &c;
+    }
+
+    ~membership() {
+      std::lock_guard<std::mutex> lock(mutex());
+      counters **link = &head();
+      while (*link != &c) {
+        link = &(*link)->next;
+      }
+      *link = c.next;
+      gone().node += c.node;
+      gone().overhead += c.overhead;
+      gone().slack += c.slack;
+    }
+  };
+
+  /// the counters of the calling thread
+  static counters & mine() {
+    thread_local membership m;
+    return m.c;
+  }
+
+  /// the guard of the list and of the counts of exited threads, never destroyed since threads may exit during static destruction
+  static std::mutex & mutex() {
+    static std::mutex *m = new std::mutex;
+    return *m;
+  }
+
+  /// the counters of the most recent thread to report
+  static counters *& head() {
+    static counters *first = nullptr;
+    return first;
+  }
+
+  /// the counts of the threads that have exited
+  static totals & gone() {
+    static totals *t = new totals;
+    return *t;
+  }
+};
+
+#endif // __LOOPMEMORY_H__
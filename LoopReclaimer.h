@@ -0,0 +1,111 @@
+#ifndef __LOOPRECLAIMER_H__
+#define __LOOPRECLAIMER_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * \class LoopReclaimer
+ * \brief A process-wide background thread that frees the nodes loops hand it with defer_destroy
+ *
+ * \detail The thread starts the first time anything is deferred and frees each piece of garbage in the order it arrived. At exit it frees whatever is still queued before it stops, so nothing deferred leaks. Since the values are destroyed on the reclaimer thread, their destructors must not depend on the thread they run on.
+ */
+class LoopReclaimer {
+public:
+  /**
+   * \struct garbage
+   * \brief Something whose destructor frees memory, queued to be destroyed on the reclaimer thread
+   */
+  struct garbage {
+    virtual ~garbage() { }
+  };
+
+
+  /**
+   * \brief Function defer to queue garbage to be destroyed on the reclaimer thread
+   *
+   * \detail Takes a lock and appends to a queue, without waiting for the reclaimer.
+   */
+  static void defer(std::unique_ptr<garbage> g) {
+    LoopReclaimer & r = instance();
+    {
+      std::lock_guard<std::mutex> lock(r.mutex);
+      r.queue.push_back(std::move(g));
+    }
+    r.wakeup.notify_one();
+  }
+
+
+  /**
+   * \brief Function drain to wait until everything deferred so far has been freed
+   */
+  static void drain() {
+    LoopReclaimer & r = instance();
+    std::unique_lock<std::mutex> lock(r.mutex);
+    r.idle.wait(lock, [&r] { return r.queue.empty() && !r.busy; });
+  }
+
+
+  /**
+   * \brief Function pending to count the pieces of garbage not yet freed
+   */
+  static size_t pending() {
+    LoopReclaimer & r = instance();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.queue.size() + (r.busy ? 1 : 0);
+  }
+
+private:
+  LoopReclaimer() : stopping(false), busy(false), worker([this] { run(); }) { }
+
+  /// frees what is left in the queue and stops the thread
+  ~LoopReclaimer() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wakeup.notify_one();
+    worker.join();
+  }
+
+  /// the reclaimer, started on first use
+  static LoopReclaimer & instance() {
+    static LoopReclaimer r;
+    return r;
+  }
+
+  /// destroys queued garbage outside the lock until stopped with an empty queue
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wakeup.wait(lock, [this] { return stopping || !queue.empty(); });
+      if (queue.empty()) {
+        return;
+      }
+      std::unique_ptr<garbage> g = std::move(queue.front());
+      queue.pop_front();
+      busy = true;
+      lock.unlock();
+      g.reset();
+      lock.lock();
+      busy = false;
+      if (queue.empty()) {
+        idle.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex;                              ///< the guard of everything below
+  std::condition_variable wakeup;                ///< signalled when garbage arrives or the reclaimer stops
+  std::condition_variable idle;                  ///< signalled when the queue has been emptied
+  std::deque<std::unique_ptr<garbage>> queue;    ///< the garbage waiting to be destroyed, oldest first
+  bool stopping;                                 ///< set at exit, after which the queue is emptied and the thread ends
+  bool busy;                                     ///< true while the thread destroys garbage outside the lock
+  std::thread worker;                            ///< the reclaimer thread, started last
+};
+
+#endif // __LOOPRECLAIMER_H__
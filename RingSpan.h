@@ -0,0 +1,237 @@
+#ifndef __RINGSPAN_H__
+#define __RINGSPAN_H__
+
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "DataLoop.h"
+#include "TDataLoop.h"
+
+/**
+ * \class RingSpan
+ * \brief A read-only ring over an external contiguous buffer of T
+ *
+ * \detail A RingSpan does not own or copy its values. It refers to size values already in a buffer, such as a std::vector or a mapped file, and reads them as a loop beginning at a start index and wrapping around the end of the buffer. It offers the read-only parts of the DataLoop interface (rotation with operator^, iteration, operator<< and comparison with DataLoops) with no allocation at all. Rotating moves only the start index, in O(1). The buffer must outlive the span and must not be resized while the span is used.
+ */
+template<typename T>
+class RingSpan {
+public:
+  /**
+   * \class const_iterator
+   * \brief A random access iterator that visits each value once, beginning at start and wrapping around the end of the buffer
+   */
+  class const_iterator {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T * pointer;
+    typedef const T & reference;
+
+    const_iterator() : span(nullptr), index(0) { }
+
+    reference operator*() const { return (*span)[index]; }
+    pointer operator->() const { return &(*span)[index]; }
+    reference operator[](difference_type n) const { return (*span)[index + n]; }
+
+    const_iterator & operator++() { index++; return *this; }
+    const_iterator operator++(int) { const_iterator old = *this; index++; return old; }
+    const_iterator & operator--() { index--; return *this; }
+    const_iterator operator--(int) { const_iterator old = *this; index--; return old; }
+    const_iterator & operator+=(difference_type n) { index += n; return *this; }
+    const_iterator & operator-=(difference_type n) { index -= n; return *this; }
+    const_iterator operator+(difference_type n) const { return const_iterator(span, index + n); }
+    const_iterator operator-(difference_type n) const { return const_iterator(span, index - n); }
+    friend const_iterator operator+(difference_type n, const const_iterator & it) { return it + n; }
+    difference_type operator-(const const_iterator & rhs) const {
+      return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+    }
+
+    bool operator==(const const_iterator & rhs) const { return index == rhs.index; }
+    bool operator!=(const const_iterator & rhs) const { return index != rhs.index; }
+    bool operator<(const const_iterator & rhs) const { return index < rhs.index; }
+    bool operator>(const const_iterator & rhs) const { return index > rhs.index; }
+    bool operator<=(const const_iterator & rhs) const { return index <= rhs.index; }
+    bool operator>=(const const_iterator & rhs) const { return index >= rhs.index; }
+
+  private:
+    friend class RingSpan;
+    const_iterator(const RingSpan * s, size_t i) : span(s), index(i) { }
+
+    const RingSpan *span;  ///< the span being iterated
+    size_t index;          ///< the number of steps taken from start
+  };
+
+  /**
+   * \brief The default constructor creates an empty RingSpan
+   */
+  RingSpan() : data(nullptr), count(0), start(0) { }
+
+  /**
+   * \brief Creates a RingSpan over size values beginning at data, starting at index start
+   *
+   * \param[in] data The first value of the buffer
+   *
+   * \param[in] size The number of values in the buffer
+   *
+   * \param[in] start The index of the value the ring starts at, reduced modulo size
+   */
+  RingSpan(const T * data, size_t size, size_t start = 0)
+    : data(data), count(size), start(size ? start % size : 0) { }
+
+  /**
+   * \brief Creates a RingSpan over the values of a vector, starting at index start
+   *
+   * \param[in] values The vector to read, which must not be resized while the span is used
+   *
+   * \param[in] start The index of the value the ring starts at, reduced modulo the size of values
+   */
+  RingSpan(const std::vector<T> & values, size_t start = 0)
+    : RingSpan(values.data(), values.size(), start) { }
+
+
+  /**
+   * \brief Overloaded operator^ to rotate the start of the RingSpan
+   *
+   * \detail Moves the start forward for a positive offset and backward for a negative offset, as DataLoop::operator^ does, but in O(1) since only the start index changes. The buffer is not touched.
+   *
+   * \param[in] offset The number of positions to move the start
+   *
+   * \return A reference to the rotated RingSpan
+   */
+  RingSpan & operator^(int offset) {
+    if (count > 1) {
+      long steps = offset % static_cast<long>(count);
+      if (steps < 0) {
+        steps += count;
+      }
+      start = (start + steps) % count;
+    }
+    return *this;
+  }
+
+
+  /**
+   * \brief Overloaded operator[] to read the value pos positions after start, wrapping around the end of the buffer
+   */
+  const T & operator[](size_t pos) const {
+    size_t i = start + pos % count;
+    return data[i < count ? i : i - count];
+  }
+
+
+  /**
+   * \brief Function length to count the values in the RingSpan
+   *
+   * \return The number of values, as DataLoop::length reports it
+   */
+  int length() const { return static_cast<int>(count); }
+
+
+  /**
+   * \brief Function size to count the values in the RingSpan
+   */
+  size_t size() const { return count; }
+
+
+  /**
+   * \brief Function start_index to report where in the buffer the ring starts
+   */
+  size_t start_index() const { return start; }
+
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, count); }
+
+
+  /**
+   * \brief Overloaded operator== to compare the values of two RingSpans in order, each from its own start
+   */
+  bool operator==(const RingSpan & rhs) const { return count == rhs.count && std::equal(begin(), end(), rhs.begin()); }
+  bool operator!=(const RingSpan & rhs) const { return !(*this == rhs); }
+
+
+  /**
+   * \brief Overloaded operator== to compare the values of the RingSpan with those of a DataLoop, each from its own start
+   */
+  template<size_t N>
+  bool operator==(const TDataLoop<T, N> & rhs) const { return same_values(rhs); }
+  template<size_t N>
+  bool operator!=(const TDataLoop<T, N> & rhs) const { return !same_values(rhs); }
+
+  template<size_t N>
+  friend bool operator==(const TDataLoop<T, N> & lhs, const RingSpan & rhs) { return rhs == lhs; }
+  template<size_t N>
+  friend bool operator!=(const TDataLoop<T, N> & lhs, const RingSpan & rhs) { return rhs != lhs; }
+
+
+  /**
+   * \brief Function is_rotation_of to test whether two RingSpans hold the same ring of values, whatever their starts
+   *
+   * \detail Compares the least rotations of both rings with the two-index method, in O(n) comparisons and no extra memory. T needs operator== and operator<.
+   *
+   * \param[in] rhs The RingSpan to compare with
+   *
+   * \return True if rotating rhs can make it equal to *this
+   */
+  bool is_rotation_of(const RingSpan & rhs) const {
+    if (count != rhs.count) {
+      return false;
+    }
+
+    // i and j are candidate starts in each ring, and k values from them have matched so far
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+    while (i < count && j < count && k < count) {
+      const T & a = (*this)[i + k];
+      const T & b = rhs[j + k];
+      if (a == b) {
+        k++;
+      }
+      else {
+        // no start from i to i + k can be least in the ring that compares greater
+        if (b < a) {
+          i += k + 1;
+        }
+        else {
+          j += k + 1;
+        }
+        k = 0;
+      }
+    }
+    return k == count || count == 0;
+  }
+
+
+  /**
+   * \brief Overloaded output stream operator<< to print the RingSpan in the format of a DataLoop
+   *
+   * \detail Prints "-> data1 <--> data2 <--> ... <--> datax <-" beginning with the value at start, or ">no values<" if the RingSpan is empty.
+   */
+  friend std::ostream & operator<<(std::ostream & os, const RingSpan & rs) {
+    if (rs.count == 0) {
+      return os << ">no values<";
+    }
+    os << "-> ";
+    for (size_t i = 0; i < rs.count; i++) {
+      os << rs[i] << (i == rs.count - 1 ? " <-" : " <--> ");
+    }
+    return os;
+  }
+
+private:
+  /// compares with a DataLoop element by element, each from its own start
+  template<typename Loop>
+  bool same_values(const Loop & rhs) const {
+    return static_cast<size_t>(rhs.length()) == count && std::equal(begin(), end(), rhs.begin());
+  }
+
+  const T *data;  ///< the first value of the external buffer
+  size_t count;   ///< the number of values in the buffer
+  size_t start;   ///< the index in the buffer of the value the ring starts at
+};
+
+#endif // __RINGSPAN_H__
@@ -0,0 +1,303 @@
+#include "RingSpan.h"
+#include <array>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using std::cout;
+using std::endl;
+using std::string;
+
+#ifndef ASSERT
+#include <csignal>  // signal handler 
+#include <cstring>  // memset
+
+char programName[128];
+
+void segFaultHandler(int, siginfo_t*, void* context) {
+  char cmdbuffer[1024];
+  char resultbuffer[128];
+#ifdef __APPLE__
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext->__ss.__rip);
+#else
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+  std::string result = "";
+  FILE* pipe = popen(cmdbuffer, "r");
+  if (!pipe) throw std::runtime_error("popen() failed!");
+  try {
+    while (fgets(resultbuffer, sizeof resultbuffer, pipe) != NULL) {
+      result += resultbuffer;
+    }
+  } catch (...) {
+    pclose(pipe);
+    throw;
+  }
+  pclose(pipe);
+  cout << "Segmentation fault occured in " << result;
+#ifdef __APPLE__
+  ((ucontext_t*)context)->uc_mcontext->__ss.__rip += 2;  // skip the seg fault
+#else
+  ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP] += 2;  // skip the seg fault
+#endif
+}
+
+#define ASSERT(cond) if (!(cond)) { \
+    cout << "failed ASSERT " << #cond << " at line " << __LINE__ << endl; \
+  } else { \
+    cout << __func__ << " - (" << #cond << ")" << " passed!" << endl; \
+  }
+#endif
+
+/**
+ * \struct RingSpanTest
+ * \defgroup RingSpanTest
+ * \brief Test cases for the RingSpan class
+ */
+struct RingSpanTest {
+  // aliases
+  using IRingSpan = RingSpan<int>;
+  using SRingSpan = RingSpan<string>;
+
+  /**
+   * \brief A test function for the constructors
+   */
+  static void ConstructorTest() {
+    IRingSpan empty;
+    ASSERT(empty.length() == 0);
+    ASSERT(empty.begin() == empty.end());
+
+    std::vector<int> v = {1, 2, 3, 4};
+    IRingSpan a(v);
+    ASSERT(a.length() == 4);
+    ASSERT(a.start_index() == 0);
+    ASSERT(a[0] == 1);
+    ASSERT(a[3] == 4);
+    ASSERT(a[4] == 1);
+
+    // the start is reduced modulo the size
+    IRingSpan b(v, 6);
+    ASSERT(b.start_index() == 2);
+    ASSERT(b[0] == 3);
+    ASSERT(b[2] == 1);
+
+    // a raw buffer works as well as a vector, and nothing is copied
+    int raw[] = {7, 8, 9};
+    IRingSpan c(raw, 3, 1);
+    ASSERT(&c[0] == &raw[1]);
+    raw[1] = 80;
+    ASSERT(c[0] == 80);
+
+    // my tests
+    IRingSpan zero(raw, 0, 5);
+    ASSERT(zero.start_index() == 0);
+    ASSERT(zero.length() == 0);
+  }
+
+  /**
+   * \brief A test function for operator^
+   */
+  static void OperatorShiftTest() {
+    std::vector<int> v = {1, 2, 3, 4, 5};
+    IRingSpan a(v);
+
+    a ^ 2;
+    ASSERT(a.start_index() == 2);
+    ASSERT(a[0] == 3);
+
+    a ^ -3;
+    ASSERT(a.start_index() == 4);
+    ASSERT(a[0] == 5);
+
+    // offsets larger than the length wrap around
+    a ^ 11;
+    ASSERT(a.start_index() == 0);
+    a ^ -12;
+    ASSERT(a.start_index() == 3);
+
+    // the buffer is untouched
+    ASSERT(v[0] == 1);
+    ASSERT(v[4] == 5);
+
+    // my tests
+    IRingSpan empty;
+    empty ^ 3;
+    ASSERT(empty.start_index() == 0);
+  }
+
+  /**
+   * \brief A test function for the iterators
+   */
+  static void IteratorTest() {
+    std::vector<int> v = {1, 2, 3, 4, 5};
+    IRingSpan a(v, 3);
+
+    std::vector<int> seen(a.begin(), a.end());
+    ASSERT((seen == std::vector<int>{4, 5, 1, 2, 3}));
+
+    int sum = 0;
+    for (int x : a) {
+      sum += x;
+    }
+    ASSERT(sum == 15);
+
+    IRingSpan::const_iterator it = a.end();
+    --it;
+    ASSERT(*it == 3);
+    ASSERT(a.end() - a.begin() == 5);
+    ASSERT(a.begin()[2] == 1);
+    ASSERT(*(a.begin() + 4) == 3);
+
+    // standard algorithms see the ring in order from start
+    ASSERT(*std::max_element(a.begin(), a.end()) == 5);
+    ASSERT(std::find(a.begin(), a.end(), 1) - a.begin() == 2);
+
+    // my tests
+    std::vector<string> words = {"x", "yy"};
+    SRingSpan s(words, 1);
+    ASSERT(s.begin()->size() == 2);
+  }
+
+  /**
+   * \brief A test function for operator<<
+   */
+  static void OperatorStreamInsertionTest() {
+    std::stringstream ss;
+    IRingSpan empty;
+    ss << empty;
+    ASSERT(ss.str() == ">no values<");
+
+    std::vector<int> v = {1, 2, 3};
+    IRingSpan a(v, 2);
+    ss.str("");
+    ss << a;
+    ASSERT(ss.str() == "-> 3 <--> 1 <--> 2 <-");
+
+    // the same text as the DataLoop it stands for
+    DataLoop d;
+    d += 3;
+    d += 1;
+    d += 2;
+    std::stringstream ds;
+    ds << d;
+    ASSERT(ss.str() == ds.str());
+
+    // my tests
+    std::vector<string> words = {"one"};
+    ss.str("");
+    ss << SRingSpan(words);
+    ASSERT(ss.str() == "-> one <-");
+  }
+
+  /**
+   * \brief A test function for operator== and operator!=
+   */
+  static void OperatorEqualityTest() {
+    std::vector<int> v = {1, 2, 3};
+    std::vector<int> w = {3, 1, 2};
+    IRingSpan a(v);
+    IRingSpan b(w, 1);
+    ASSERT(a == b);
+    b ^ 1;
+    ASSERT(a != b);
+
+    // against a DataLoop
+    DataLoop d;
+    d += 2;
+    d += 3;
+    d += 1;
+    ASSERT(a != d);
+    a ^ 1;
+    ASSERT(a == d);
+    ASSERT(d == a);
+    d += 4;
+    ASSERT(a != d);
+    ASSERT(d != a);
+
+    // against a TDataLoop
+    TDataLoop<string> t;
+    t += "b";
+    t += "c";
+    t += "a";
+    std::vector<string> words = {"a", "b", "c"};
+    SRingSpan s(words, 1);
+    ASSERT(s == t);
+    ASSERT(t == s);
+    s ^ 1;
+    ASSERT(s != t);
+    ASSERT(t != s);
+
+    // my tests
+    IRingSpan empty;
+    DataLoop none;
+    ASSERT(empty == none);
+    ASSERT(empty == IRingSpan());
+  }
+
+  /**
+   * \brief A test function for is_rotation_of
+   */
+  static void FunctionIsRotationTest() {
+    std::vector<int> v = {1, 2, 3, 1, 2};
+    std::vector<int> w = {2, 1, 2, 3, 1};
+    IRingSpan a(v);
+    IRingSpan b(w);
+    ASSERT(a.is_rotation_of(b));
+    ASSERT(b.is_rotation_of(a));
+    ASSERT(a.is_rotation_of(a));
+
+    // the same values in another cyclic order
+    std::vector<int> x = {1, 1, 2, 2, 3};
+    ASSERT(!a.is_rotation_of(IRingSpan(x)));
+
+    // different lengths
+    std::vector<int> y = {1, 2, 3};
+    ASSERT(!IRingSpan(y).is_rotation_of(a));
+
+    // repeated values
+    std::vector<int> z1 = {5, 5, 5, 5};
+    std::vector<int> z2 = {5, 5, 5, 5};
+    ASSERT(IRingSpan(z1, 2).is_rotation_of(IRingSpan(z2)));
+    z2[3] = 4;
+    ASSERT(!IRingSpan(z1).is_rotation_of(IRingSpan(z2)));
+
+    // my tests
+    std::vector<string> s1 = {"ab", "cd", "ef"};
+    std::vector<string> s2 = {"ef", "ab", "cd"};
+    ASSERT(SRingSpan(s1).is_rotation_of(SRingSpan(s2)));
+    ASSERT(IRingSpan().is_rotation_of(IRingSpan()));
+
+    // every rotation of an array is found, and no swap of two values is
+    std::array<int, 6> arr = {{4, 1, 4, 1, 2, 1}};
+    IRingSpan base(arr.data(), arr.size());
+    bool all = true;
+    for (size_t i = 0; i < arr.size(); i++) {
+      all = all && base.is_rotation_of(IRingSpan(arr.data(), arr.size(), i));
+    }
+    ASSERT(all);
+    std::array<int, 6> swapped = {{1, 4, 4, 1, 2, 1}};
+    ASSERT(!base.is_rotation_of(IRingSpan(swapped.data(), swapped.size())));
+  }
+};
+
+int main(int, char* argv[]) {
+  cout << "Testing RingSpan" << endl;
+  // register a seg fault handler
+  sprintf(programName, "%s", argv[0]);
+  struct sigaction signalAction;
+  memset(&signalAction, 0, sizeof(struct sigaction));
+  signalAction.sa_flags = SA_SIGINFO;
+  signalAction.sa_sigaction = segFaultHandler;
+  sigaction(SIGSEGV, &signalAction, NULL);
+
+  RingSpanTest::ConstructorTest();   // int
+  RingSpanTest::OperatorShiftTest();   // int
+  RingSpanTest::IteratorTest();   // int, string
+  RingSpanTest::OperatorStreamInsertionTest();   // int, string
+  RingSpanTest::OperatorEqualityTest();   // int, string
+  RingSpanTest::FunctionIsRotationTest();   // int, string
+  
+  return 0;
+}
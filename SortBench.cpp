@@ -0,0 +1,67 @@
+#include "DataLoop.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+// times sorting a DataLoop of n pseudo-random ints in place against copying it out to a
+// std::vector, sorting that and rebuilding the loop
+// usage: SortBench [n] [rebuild|sort|parallel_sort|radix_sort]
+// each case refills the loop from the memory the case before it freed, in a scattered order,
+// so naming one case per run gives the fairest comparison
+
+// fills a DataLoop with the same n pseudo-random values every time
+static void fill(DataLoop & dl, size_t n) {
+    unsigned seed = 1;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        dl += static_cast<int>(seed >> 1);
+    }
+}
+
+// runs f on a freshly filled DataLoop and returns the milliseconds it took
+template<typename F>
+static double time_sort(size_t n, F f) {
+    DataLoop dl;
+    fill(dl, n);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    f(dl);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    if (!std::is_sorted(dl.begin(), dl.end())) {
+        cout << "not sorted" << endl;
+    }
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    cout << "Sorting " << n << " ints" << endl;
+
+    std::string only = argc > 2 ? argv[2] : "";
+
+    if (only.empty() || only == "rebuild") {
+        cout << "copy to vector, sort, rebuild: " << time_sort(n, [](DataLoop & dl) {
+            std::vector<int> values(dl.begin(), dl.end());
+            std::sort(values.begin(), values.end());
+            dl.clear();
+            for (size_t i = 0; i < values.size(); i++) {
+                dl += values[i];
+            }
+        }) << " ms" << endl;
+    }
+    if (only.empty() || only == "sort") {
+        cout << "sort: " << time_sort(n, [](DataLoop & dl) { dl.sort(); }) << " ms" << endl;
+    }
+    if (only.empty() || only == "parallel_sort") {
+        cout << "parallel_sort: " << time_sort(n, [](DataLoop & dl) { dl.parallel_sort(); }) << " ms" << endl;
+    }
+    if (only.empty() || only == "radix_sort") {
+        cout << "radix_sort: " << time_sort(n, [](DataLoop & dl) { dl.radix_sort(); }) << " ms" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "StaticDataLoop.h"
+#include "TDataLoop.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using std::cout;
+using std::endl;
+
+// compares StaticDataLoop, whose nodes are array slots inside the object, with the heap nodes of TDataLoop
+// for loops of a capacity known at compile time: filling the loop, walking it, rotating it, adding past
+// the capacity (a TDataLoop bounded with set_capacity) and removing and adding back values
+// usage: StaticBench [rounds]
+// each operation is repeated rounds times on a loop of 64 and of 4096 values
+
+// returns the milliseconds since begin
+static double since(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// makes an empty loop of capacity N
+template<typename Loop, size_t N>
+struct make_loop {
+    static Loop make() { return Loop(); }
+};
+
+template<size_t N>
+struct make_loop<TDataLoop<int>, N> {
+    static TDataLoop<int> make() {
+        TDataLoop<int> dl;
+        dl.set_capacity(N);
+        return dl;
+    }
+};
+
+// times each operation on a Loop of capacity N and prints the results under name
+template<typename Loop, size_t N>
+static void run(const std::string & name, int rounds) {
+    long long sum = 0;
+
+    // the StaticDataLoop is static so that a large one does not overflow the stack
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        static Loop dl;
+        dl = make_loop<Loop, N>::make();
+        for (size_t i = 0; i < N; i++) {
+            dl += static_cast<int>(i);
+        }
+        sum += dl.length();
+    }
+    double fill = since(begin);
+
+    static Loop dl;
+    dl = make_loop<Loop, N>::make();
+    for (size_t i = 0; i < N; i++) {
+        dl += static_cast<int>(i);
+    }
+
+    begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const int & value : dl) {
+            sum += value;
+        }
+    }
+    double walk = since(begin);
+
+    begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        dl ^ (r % 2 ? -1 : 1) * static_cast<int>(N / 3);
+    }
+    double rotate = since(begin);
+
+    begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < N; i++) {
+            dl += r;
+        }
+    }
+    double overwrite = since(begin);
+
+    begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < 16; i++) {
+            sum += dl.remove_at_offset(static_cast<int>(i));
+        }
+        for (int i = 0; i < 16; i++) {
+            dl += i;
+        }
+    }
+    double churn = since(begin);
+
+    cout << name << ": fill " << fill << " ms, walk " << walk << " ms, rotate " << rotate << " ms, "
+         << "overwrite " << overwrite << " ms, remove and add " << churn << " ms"
+         << (sum == 0 ? " (bad sum)" : "") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    cout << "Repeating each operation " << rounds << " times" << endl;
+
+    run<StaticDataLoop<int, 64>, 64>("static 64", rounds * 64);
+    run<TDataLoop<int>, 64>("heap 64", rounds * 64);
+    run<StaticDataLoop<int, 4096>, 4096>("static 4096", rounds);
+    run<TDataLoop<int>, 4096>("heap 4096", rounds);
+    return 0;
+}
@@ -0,0 +1,232 @@
+#ifndef __STATICDATALOOP_H__
+#define __STATICDATALOOP_H__
+
+#include <iostream>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * \class StaticDataLoop
+ * \brief A dataloop of at most N values held in an array inside the object, usable in constant expressions
+ *
+ * \detail The nodes are N array slots linked by index, so the loop never allocates and can be copied like any aggregate. A removed slot goes on a free list and is reused before untouched ones. With a fixed capacity the loop behaves like a TDataLoop bounded by set_capacity(N): once full, operator+= overwrites the oldest value, in the start node, and moves start past it, and a splice that overflows drops values from the new start until N remain. Every function is constexpr under C++20, so a loop can be built and read at compile time, for example to make a lookup table. T must be default constructible and copy assignable, since each slot always holds a T.
+ *
+ * \tparam T The type of the values
+ *
+ * \tparam N The capacity
+ */
+template<typename T, size_t N>
+class StaticDataLoop {
+  static_assert(N > 0, "a StaticDataLoop needs room for at least one value");
+
+  struct _Node;
+
+    public:
+  /**
+   * \class basic_iterator
+   * \brief A bidirectional iterator that visits each node once, beginning at start
+   *
+   * \detail Like the DataLoop iterator it counts its steps from start, and end() is start after count steps.
+   */
+  template<bool Const>
+  class basic_iterator {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T, T>::type * pointer;
+    typedef typename std::conditional<Const, const T, T>::type & reference;
+    typedef typename std::conditional<Const, const StaticDataLoop, StaticDataLoop>::type loop_type;
+
+    constexpr basic_iterator() : loop(nullptr), slot(0), steps(0) { }
+
+    /// a const_iterator can be made from an iterator
+    template<bool C = Const, typename = typename std::enable_if<C>::type>
+    constexpr basic_iterator(const basic_iterator<false> & it) : loop(it.loop), slot(it.slot), steps(it.steps) { }
+
+    constexpr reference operator*() const { return loop->nodes[slot].data; }
+    constexpr pointer operator->() const { return &loop->nodes[slot].data; }
+
+    constexpr basic_iterator & operator++() { slot = loop->nodes[slot].next; steps++; return *this; }
+    constexpr basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; }
+    constexpr basic_iterator & operator--() { slot = loop->nodes[slot].prev; steps--; return *this; }
+    constexpr basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; }
+
+    constexpr bool operator==(const basic_iterator & rhs) const { return steps == rhs.steps; }
+    constexpr bool operator!=(const basic_iterator & rhs) const { return !(*this == rhs); }
+
+  private:
+    friend class StaticDataLoop;
+    friend class basic_iterator<!Const>;
+    constexpr basic_iterator(loop_type * l, size_t s, size_t n) : loop(l), slot(s), steps(n) { }
+
+    loop_type *loop;  ///< the loop the iterator walks
+    size_t slot;      ///< the slot of the current node
+    size_t steps;     ///< the number of steps taken from start
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  /**
+   * \brief The default constructor
+   *
+   * \detail Creates an empty StaticDataLoop
+   */
+  constexpr StaticDataLoop() = default;
+
+  /**
+   * \brief An alternate constructor
+   *
+   * \detail Creates a StaticDataLoop with one node holding value
+   */
+  constexpr StaticDataLoop(const T & value);
+
+  /**
+   * \brief An alternate constructor
+   *
+   * \detail Adds the values in order with operator+=, so only the last N are kept
+   */
+  constexpr StaticDataLoop(std::initializer_list<T> values);
+
+  /**
+   * \brief Helper function to empty the StaticDataLoop
+   *
+   * \detail Forgets every node in O(1); the values stay in their slots until overwritten
+   */
+  constexpr void clear();
+
+
+  /**
+   * \brief Overloaded operator== to check if two StaticDataLoops hold the same values in the same order from start
+   *
+   * \detail The capacities may differ.
+   */
+  template<size_t M>
+  constexpr bool operator==(const StaticDataLoop<T, M> & rhs) const;
+
+
+  /**
+   * \brief Overloaded operator+= to add a value to the end of this StaticDataLoop
+   *
+   * \detail The end of the loop is the node before start. If the loop is full, the value overwrites the oldest one, in the start node, and start moves to the next node instead.
+   */
+  constexpr StaticDataLoop & operator+=(const T & value);
+
+
+  /**
+   * \brief Overloaded operator^ to shift the start position forward for a positive offset and backward for a negative offset
+   */
+  constexpr StaticDataLoop & operator^(int offset);
+
+
+  /**
+   * \brief Function splice to insert the values of another StaticDataLoop into this one
+   *
+   * \detail As TDataLoop::splice on a DataLoop bounded to N: position 0 inserts rhs before start and makes the start of rhs the new start, position n inserts rhs after node n, looping around as needed, and if more than N values result, values are dropped from the new start until N remain. Since each loop has its own array, the values are copied into free slots rather than relinked. rhs is left empty.
+   *
+   * \param[in] rhs A reference to a StaticDataLoop object, of any capacity, to insert into *this
+   *
+   * \param[in] pos The insertion position
+   *
+   * \return A reference to the updated StaticDataLoop object
+   */
+  template<size_t M>
+  constexpr StaticDataLoop & splice(StaticDataLoop<T, M> & rhs, size_t pos);
+
+
+  /**
+   * \brief Function remove_at_offset to shift the start position by offset and remove that node
+   *
+   * \detail As DataLoop::remove_at_offset, start moves on to the node after the one removed, whose slot is freed.
+   *
+   * \return The value of the removed node
+   *
+   * \throw std::out_of_range if the StaticDataLoop is empty
+   */
+  constexpr T remove_at_offset(int offset);
+
+
+  /**
+   * \brief Overloaded operator[] to read the value pos places from start, looping around as needed
+   *
+   * \detail Walks the shorter way round, so it takes up to count / 2 steps.
+   *
+   * \throw std::out_of_range if the StaticDataLoop is empty
+   */
+  constexpr const T & operator[](size_t pos) const;
+
+
+  /**
+   * \brief Function length to report the number of nodes in *this StaticDataLoop
+   */
+  constexpr int length() const { return static_cast<int>(count); }
+
+
+  /**
+   * \brief Function capacity to report the greatest number of values the StaticDataLoop holds
+   */
+  static constexpr size_t capacity() { return N; }
+
+
+  /**
+   * \brief Functions begin and end to iterate over the StaticDataLoop from the start node
+   */
+  constexpr iterator begin() { return iterator(this, start, 0); }
+  constexpr iterator end() { return iterator(this, start, count); }
+  constexpr const_iterator begin() const { return const_iterator(this, start, 0); }
+  constexpr const_iterator end() const { return const_iterator(this, start, count); }
+
+
+  /**
+   * \brief Overloaded output stream operator<< to print the StaticDataLoop
+   *
+   * \detail Prints "-> data1 <--> data2 <--> ... <--> datax <-" where data1 is the value in the start node, or ">no values<" if the StaticDataLoop is empty.
+   */
+  template<typename U, size_t M>
+  friend std::ostream & operator<<(std::ostream & os, const StaticDataLoop<U, M> & dl);
+
+private:
+  /// friend StaticDataLoopTest struct to allow the test struct access to the private data
+  friend struct StaticDataLoopTest;
+
+  /// loops of other capacities, for operator== and splice
+  template<typename, size_t> friend class StaticDataLoop;
+
+  /// the slot number that stands for no node
+  static constexpr size_t none = N;
+
+  /**
+   * \struct _Node
+   * \brief A private structure to represent a node in a StaticDataLoop
+   */
+  struct _Node {
+    T data{};            ///< the node data
+    size_t next = none;  ///< the slot of the next node, or the next free slot
+    size_t prev = none;  ///< the slot of the previous node
+  };
+
+  /// takes a slot from the free list or from the untouched slots, which must not be exhausted
+  constexpr size_t take_slot();
+
+  /// stores value in a free slot linked in before slot pos, or as the only node if pos is none, without changing start
+  constexpr size_t link_before(size_t pos, const T & value);
+
+  /// unlinks the node in slot and puts the slot on the free list, moving start on if needed
+  constexpr void unlink(size_t slot);
+
+  /// the slot of the node shifted offset places from start, walking the shorter way round
+  constexpr size_t slot_at(long offset) const;
+
+  _Node nodes[N] = {};       ///< the slots
+  size_t start = none;       ///< the slot of the start node
+  size_t count = 0;          ///< the number of nodes in the loop
+  size_t free_head = none;   ///< the first slot of the free list
+  size_t used = 0;           ///< the number of slots ever taken; slots from used on are untouched
+};
+
+#include "StaticDataLoop.inc"
+#endif // __STATICDATALOOP_H__
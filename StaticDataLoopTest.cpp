@@ -0,0 +1,344 @@
+#include "StaticDataLoop.h"
+#include "TDataLoop.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using std::cout;
+using std::endl;
+using std::string;
+
+#ifndef ASSERT
+#include <csignal>  // signal handler 
+#include <cstring>  // memset
+
+char programName[128];
+
+void segFaultHandler(int, siginfo_t*, void* context) {
+  char cmdbuffer[1024];
+  char resultbuffer[128];
+#ifdef __APPLE__
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext->__ss.__rip);
+#else
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+  std::string result = "";
+  FILE* pipe = popen(cmdbuffer, "r");
+  if (!pipe) throw std::runtime_error("popen() failed!");
+  try {
+    while (fgets(resultbuffer, sizeof resultbuffer, pipe) != NULL) {
+      result += resultbuffer;
+    }
+  } catch (...) {
+    pclose(pipe);
+    throw;
+  }
+  pclose(pipe);
+  cout << "Segmentation fault occured in " << result;
+#ifdef __APPLE__
+  ((ucontext_t*)context)->uc_mcontext->__ss.__rip += 2;  // skip the seg fault
+#else
+  ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP] += 2;  // skip the seg fault
+#endif
+}
+
+#define ASSERT(cond) if (!(cond)) { \
+    cout << "failed ASSERT " << #cond << " at line " << __LINE__ << endl; \
+  } else { \
+    cout << __func__ << " - (" << #cond << ")" << " passed!" << endl; \
+  }
+#endif
+
+/// builds, at compile time, a loop of the squares of 0 .. 7 rotated to start at 3 * 3
+constexpr StaticDataLoop<int, 8> squares() {
+  StaticDataLoop<int, 8> dl;
+  for (int i = 0; i < 8; i++) {
+    dl += i * i;
+  }
+  return dl ^ 3;
+}
+
+/// adds 1 .. 6 to a loop with room for four, and splices 10 and 11 in after the first node, at compile time
+constexpr StaticDataLoop<int, 4> overflowed() {
+  StaticDataLoop<int, 4> dl;
+  for (int i = 1; i <= 6; i++) {
+    dl += i;
+  }
+  StaticDataLoop<int, 2> more{10, 11};
+  dl.splice(more, 1);
+  dl.remove_at_offset(1);
+  return dl;
+}
+
+/// adds 1 .. 3 to a loop with room for one, and splices 7, 8 and 9 in after its only node, at compile time
+constexpr StaticDataLoop<int, 1> single() {
+  StaticDataLoop<int, 1> dl;
+  for (int i = 1; i <= 3; i++) {
+    dl += i;
+  }
+  StaticDataLoop<int, 3> more{7, 8, 9};
+  dl.splice(more, 1);
+  return dl;
+}
+
+/// fills a loop with room for three, removes its middle value and adds 4 and 5, at compile time
+constexpr StaticDataLoop<int, 3> refilled() {
+  StaticDataLoop<int, 3> dl{1, 2, 3};
+  dl.remove_at_offset(1);
+  dl += 4;
+  dl += 5;
+  return dl;
+}
+
+/**
+ * \struct StaticDataLoopTest
+ * \defgroup StaticDataLoopTest
+ * \brief Test cases for the StaticDataLoop class
+ */
+struct StaticDataLoopTest {
+  // aliases
+  using ISDataLoop = StaticDataLoop<int, 5>;
+  using SSDataLoop = StaticDataLoop<string, 3>;
+
+  /// prints any printable object, for comparing the formats of two kinds of loop
+  template<typename Loop>
+  static string text(const Loop & dl) {
+    std::stringstream ss;
+    ss << dl;
+    return ss.str();
+  }
+
+  /**
+   * \brief A test function for loops built in constant expressions
+   */
+  static void ConstexprTest() {
+    constexpr StaticDataLoop<int, 8> table = squares();
+    static_assert(table.length() == 8);
+    static_assert(table[0] == 9);
+    static_assert(table[5] == 0);
+    static_assert(table[7] == 4);
+    static_assert(table == StaticDataLoop<int, 8>{9, 16, 25, 36, 49, 0, 1, 4});
+    ASSERT(text(table) == "-> 9 <--> 16 <--> 25 <--> 36 <--> 49 <--> 0 <--> 1 <--> 4 <-");
+
+    // 1 .. 6 leaves 3 4 5 6, the splice gives 3 10 11 4 5 6 and drops 3 and 10, and the removal takes 4
+    constexpr StaticDataLoop<int, 4> small = overflowed();
+    static_assert(small == StaticDataLoop<int, 3>{5, 6, 11});
+    ASSERT(text(small) == "-> 5 <--> 6 <--> 11 <-");
+
+    // my tests
+    constexpr StaticDataLoop<char, 3> letters{'a', 'b', 'c', 'd'};
+    static_assert(letters[0] == 'b');
+    static_assert(StaticDataLoop<char, 3>::capacity() == 3);
+    ASSERT(letters.length() == 3);
+  }
+
+  /**
+   * \brief A test function for the constructors, operator+= and operator<<
+   */
+  static void OperatorPlusGetsTest() {
+    ISDataLoop empty;
+    ASSERT(empty.length() == 0);
+    ASSERT(empty.start == ISDataLoop::none);
+    ASSERT(text(empty) == ">no values<");
+
+    // once full, the oldest value is overwritten as in a bounded TDataLoop
+    ISDataLoop a;
+    TDataLoop<int> t;
+    t.set_capacity(5);
+    bool same = true;
+    for (int i = 1; i <= 12; i++) {
+      a += i;
+      t += i;
+      same = same && text(a) == text(t);
+    }
+    ASSERT(same);
+    ASSERT(text(a) == "-> 8 <--> 9 <--> 10 <--> 11 <--> 12 <-");
+    ASSERT(a.used == 5);
+
+    SSDataLoop s("x");
+    s += "y";
+    SSDataLoop copy(s);
+    ASSERT(copy == s);
+    copy += "z";
+    ASSERT(!(copy == s));
+
+    // nothing is allocated for the nodes
+    ASSERT(sizeof(ISDataLoop) == 5 * sizeof(ISDataLoop::_Node) + 4 * sizeof(size_t));
+
+    // my tests
+    ISDataLoop::iterator it = a.begin();
+    *it = 7;
+    ISDataLoop::const_iterator cit = it;
+    ASSERT(*cit == 7);
+    cit = a.end();
+    --cit;
+    ASSERT(*cit == 12);
+    a.clear();
+    ASSERT(a.length() == 0);
+    a += 1;
+    ASSERT(text(a) == "-> 1 <-");
+  }
+
+  /**
+   * \brief A test function for operator^ and operator[]
+   */
+  static void OperatorShiftTest() {
+    ISDataLoop a{1, 2, 3, 4, 5};
+    TDataLoop<int> t;
+    for (int i = 1; i <= 5; i++) {
+      t += i;
+    }
+
+    int offsets[] = {2, -3, 11, -12, 0, 4, -1, 8};
+    bool same = true;
+    for (int offset : offsets) {
+      a ^ offset;
+      t ^ offset;
+      same = same && text(a) == text(t);
+    }
+    ASSERT(same);
+    ASSERT(a[0] == *t.handle_at(0));
+    ASSERT(a[7] == *t.handle_at(2));
+
+    bool threw = false;
+    try {
+      ISDataLoop()[0];
+    }
+    catch (const std::out_of_range &) {
+      threw = true;
+    }
+    ASSERT(threw);
+
+    // my tests
+    ISDataLoop one(4);
+    one ^ -3;
+    ASSERT(one[3] == 4);
+  }
+
+  /**
+   * \brief A test function for splice
+   */
+  static void FunctionSpliceTest() {
+    // the same results as a TDataLoop bounded to the capacity, for every position and for overflows of every size
+    bool same = true;
+    for (int ours = 0; ours <= 5; ours++) {
+      for (int theirs = 1; theirs <= 7; theirs++) {
+        for (size_t pos = 0; pos < 8; pos++) {
+          ISDataLoop a;
+          StaticDataLoop<int, 8> b;
+          TDataLoop<int> ta;
+          TDataLoop<int> tb;
+          ta.set_capacity(5);
+          for (int i = 1; i <= ours; i++) {
+            a += i;
+            ta += i;
+          }
+          for (int i = 1; i <= theirs; i++) {
+            b += 10 * i;
+            tb += 10 * i;
+          }
+          a.splice(b, pos);
+          ta.splice(tb, pos);
+          same = same && text(a) == text(ta) && b.length() == 0;
+        }
+      }
+    }
+    ASSERT(same);
+
+    // freed slots are reused before untouched ones
+    ISDataLoop a{1, 2, 3};
+    a.remove_at_offset(0);
+    ISDataLoop b{7, 8};
+    a.splice(b, 0);
+    ASSERT(text(a) == "-> 7 <--> 8 <--> 2 <--> 3 <-");
+    ASSERT(a.used == 4);
+
+    // my tests
+    a.splice(a, 2);
+    ASSERT(a.length() == 4);
+    ISDataLoop none;
+    a.splice(none, 1);
+    ASSERT(text(a) == "-> 7 <--> 8 <--> 2 <--> 3 <-");
+  }
+
+  /**
+   * \brief A test function for remove_at_offset
+   */
+  static void FunctionRemoveTest() {
+    ISDataLoop a{1, 2, 3, 4, 5};
+    ASSERT(a.remove_at_offset(2) == 3);
+    ASSERT(text(a) == "-> 4 <--> 5 <--> 1 <--> 2 <-");
+    ASSERT(a.free_head == 2);
+    a += 6;
+    ASSERT(a.free_head == ISDataLoop::none);
+    ASSERT(text(a) == "-> 4 <--> 5 <--> 1 <--> 2 <--> 6 <-");
+
+    bool threw = false;
+    try {
+      ISDataLoop().remove_at_offset(0);
+    }
+    catch (const std::out_of_range &) {
+      threw = true;
+    }
+    ASSERT(threw);
+
+    // my tests
+    // a removed slot keeps its old value, since every slot always holds a T, until the free list hands it out again
+    SSDataLoop s{"x", "y", "z"};
+    ASSERT(s.remove_at_offset(1) == "y");
+    ASSERT(s.free_head == 1);
+    ASSERT(s.nodes[1].data == "y");
+    s += "w";
+    ASSERT(s.nodes[1].data == "w");
+    ASSERT(text(s) == "-> z <--> x <--> w <-");
+  }
+
+  /**
+   * \brief A test function for loops held at their capacity in constant expressions
+   */
+  static void CapacityLimitTest() {
+    // with room for one, += overwrites the only value and a splice keeps just the last value of rhs
+    constexpr StaticDataLoop<int, 1> one = single();
+    static_assert(one.length() == 1);
+    static_assert(one[0] == 9);
+    static_assert(one.used == 1);
+    static_assert(one.free_head == StaticDataLoop<int, 1>::none);
+    static_assert(StaticDataLoop<int, 1>{1, 2, 3} == StaticDataLoop<int, 1>{3});
+    ASSERT(text(one) == "-> 9 <-");
+
+    // a full loop takes its freed slot before it overwrites, and never touches more slots than its capacity
+    constexpr StaticDataLoop<int, 3> full = refilled();
+    static_assert(full == StaticDataLoop<int, 3>{1, 4, 5});
+    static_assert(full.used == 3);
+    static_assert(full.free_head == StaticDataLoop<int, 3>::none);
+    static_assert(full.start == 0);
+    ASSERT(text(full) == "-> 1 <--> 4 <--> 5 <-");
+
+    // my tests
+    // none is N itself, one past the last slot, so no extra index is spent on it
+    static_assert(StaticDataLoop<int, 1>::none == 1);
+    static_assert(sizeof(StaticDataLoop<int, 1>) == sizeof(StaticDataLoop<int, 1>::_Node) + 4 * sizeof(size_t));
+  }
+};
+
+int main(int, char* argv[]) {
+  cout << "Testing StaticDataLoop" << endl;
+  // register a seg fault handler
+  sprintf(programName, "%s", argv[0]);
+  struct sigaction signalAction;
+  memset(&signalAction, 0, sizeof(struct sigaction));
+  signalAction.sa_flags = SA_SIGINFO;
+  signalAction.sa_sigaction = segFaultHandler;
+  sigaction(SIGSEGV, &signalAction, NULL);
+
+  StaticDataLoopTest::ConstexprTest();   // int, char
+  StaticDataLoopTest::OperatorPlusGetsTest();   // int, string
+  StaticDataLoopTest::OperatorShiftTest();   // int
+  StaticDataLoopTest::FunctionSpliceTest();   // int
+  StaticDataLoopTest::FunctionRemoveTest();   // int, string
+  StaticDataLoopTest::CapacityLimitTest();   // int
+  
+  return 0;
+}
@@ -0,0 +1,371 @@
+#include "StringDataLoop.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+
+// carves bytes from the last chunk, starting a larger one when it is full
+void * BumpAllocator::allocate(size_t bytes, size_t align) {
+    size_t pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+    if (pad + bytes > left) {
+        // a request too large for the next chunk gets a chunk of its own size
+        size_t size = std::max(next_chunk, bytes + align);
+        chunks.emplace_back(new char[size]);
+        cur = chunks.back().get();
+        left = size;
+        reserved += size;
+        next_chunk = std::min<size_t>(next_chunk * 2, 1 << 20);
+        pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+    }
+    void *p = cur + pad;
+    cur += pad + bytes;
+    left -= pad + bytes;
+    return p;
+}
+
+// adds the chunks of rhs to ours, carving on from the chunk of rhs if we have none
+void BumpAllocator::adopt(BumpAllocator & rhs) {
+    if (chunks.empty()) {
+        cur = rhs.cur;
+        left = rhs.left;
+        next_chunk = rhs.next_chunk;
+    }
+    chunks.insert(chunks.end(), std::make_move_iterator(rhs.chunks.begin()), std::make_move_iterator(rhs.chunks.end()));
+    reserved += rhs.reserved;
+    rhs.chunks.clear();
+    rhs.release();
+}
+
+// frees every chunk and starts again from the first chunk size
+void BumpAllocator::release() {
+    chunks.clear();
+    cur = nullptr;
+    left = 0;
+    reserved = 0;
+    next_chunk = first;
+}
+
+// returns the kept copy of value, copying it into the arena the first time it is seen
+std::string_view StringArena::intern(std::string_view value) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = interned.find(value);
+    if (found != interned.end()) {
+        return *found;
+    }
+    char *copy = static_cast<char *>(memory.allocate(value.size(), 1));
+    if (!value.empty()) {
+        std::memcpy(copy, value.data(), value.size());
+    }
+    std::string_view kept(copy, value.size());
+    interned.insert(kept);
+    return kept;
+}
+
+// returns the kept copy of value without making one
+std::string_view StringArena::find(std::string_view value) const {
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = interned.find(value);
+    return found == interned.end() ? std::string_view() : *found;
+}
+
+// reports the number of distinct strings interned
+size_t StringArena::distinct() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return interned.size();
+}
+
+// reports the bytes of the chunks of the copies
+size_t StringArena::bytes() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return memory.bytes();
+}
+
+// default constructor creates an empty StringDataLoop
+StringDataLoop::StringDataLoop() : start(nullptr), count(0), free(nullptr), nodes(16 * sizeof(_Node)) { }
+
+// non-default constructor that creates a StringDataLoop with one element
+StringDataLoop::StringDataLoop(std::string_view value) : start(nullptr), count(0), free(nullptr), nodes(16 * sizeof(_Node)) {
+    *this += value;
+}
+
+// copy constructor that shares the arena of rhs and copies its nodes
+StringDataLoop::StringDataLoop(const StringDataLoop & rhs) : start(nullptr), count(0), free(nullptr), nodes(16 * sizeof(_Node)) {
+    *this = rhs;
+}
+
+// move constructor that takes over the nodes and arena of rhs
+StringDataLoop::StringDataLoop(StringDataLoop && rhs) : start(rhs.start), count(rhs.count), free(nullptr), nodes(16 * sizeof(_Node)), arena(std::move(rhs.arena)) {
+    take_nodes(rhs);
+    rhs.start = nullptr;
+    rhs.count = 0;
+}
+
+// assignment operator that shares the arena of rhs and copies its nodes
+StringDataLoop & StringDataLoop::operator=(const StringDataLoop & rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    clear();
+    arena = rhs.arena;
+
+    // the values are already interned in the shared arena, so only nodes of our own are made
+    for (std::string_view value : rhs) {
+        append(value);
+    }
+    return *this;
+}
+
+// move assignment operator that hands the nodes and arena of rhs to this StringDataLoop
+StringDataLoop & StringDataLoop::operator=(StringDataLoop && rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+
+    clear();
+    take_nodes(rhs);
+    start = rhs.start;
+    count = rhs.count;
+    arena = std::move(rhs.arena);
+    rhs.start = nullptr;
+    rhs.count = 0;
+    return *this;
+}
+
+// gives back the chunks every node lives in, and lets the arena go
+void StringDataLoop::clear() {
+    start = nullptr;
+    count = 0;
+    free = nullptr;
+    nodes.release();
+    arena.reset();
+}
+
+// destructor that lets the arena go
+StringDataLoop::~StringDataLoop() {
+    clear();
+}
+
+// compares the values of both loops in order from their starts, by address first
+bool StringDataLoop::operator==(const StringDataLoop & rhs) const {
+    if (count != rhs.count) {
+        return false;
+    }
+
+    // values interned in the same arena are equal only if they are the same copy
+    bool shared = arena == rhs.arena;
+    _Node *cur_node = start;
+    _Node *rhs_node = rhs.start;
+    for (size_t i = 0; i < count; i++) {
+        bool same_copy = cur_node->data.data() == rhs_node->data.data() && cur_node->data.size() == rhs_node->data.size();
+        if (!same_copy && (shared || cur_node->data != rhs_node->data)) {
+            return false;
+        }
+        cur_node = cur_node->next;
+        rhs_node = rhs_node->next;
+    }
+    return true;
+}
+
+// interns value and adds it to the end of the StringDataLoop
+StringDataLoop & StringDataLoop::operator+=(std::string_view value) {
+    if (!arena) {
+        arena = std::make_shared<StringArena>();
+    }
+    append(arena->intern(value));
+    return *this;
+}
+
+// creates a third StringDataLoop, sharing the arena of this one, with the values of both
+StringDataLoop StringDataLoop::operator+(const StringDataLoop & rhs) const {
+    StringDataLoop new_data_loop = *this;
+    for (std::string_view value : rhs) {
+        new_data_loop += value;
+    }
+    return new_data_loop;
+}
+
+// shifts the start position forward for a positive offset and backward for a negative offset
+StringDataLoop & StringDataLoop::operator^(int offset) {
+    if (count < 2 || offset == 0) {
+        return *this;
+    }
+    start = at_offset(offset);
+    return *this;
+}
+
+// inserts the nodes of rhs at position pos, interning its values first if it uses another arena
+StringDataLoop & StringDataLoop::splice(StringDataLoop & rhs, size_t pos) {
+    if (rhs.count == 0 || &rhs == this) {
+        return *this;
+    }
+
+    // an empty loop simply takes over the nodes, and the arena they live in
+    if (count == 0) {
+        *this = std::move(rhs);
+        return *this;
+    }
+
+    if (arena != rhs.arena) {
+        // the values are copied into nodes of our arena, which may reuse our free nodes
+        StringDataLoop part;
+        part.arena = arena;
+        part.free = free;
+        for (std::string_view value : rhs) {
+            part.append(arena->intern(value));
+        }
+        free = part.free;
+        part.free = nullptr;
+        rhs.clear();
+        return splice(part, pos);
+    }
+
+    _Node *first = rhs.start;
+    _Node *last = first->prev;
+    size_t len = rhs.count;
+    take_nodes(rhs);
+    rhs.start = nullptr;
+    rhs.count = 0;
+
+    _Node *after = at_offset(static_cast<long>(pos % count));
+    _Node *before = after->prev;
+    before->next = first;
+    first->prev = before;
+    last->next = after;
+    after->prev = last;
+    count += len;
+
+    // position 0 makes rhs the front of the loop, and other multiples of count make it the back
+    if (after == start && pos == 0) {
+        start = first;
+    }
+    return *this;
+}
+
+// shifts the start position by offset, removes that node and returns its value
+std::string StringDataLoop::remove_at_offset(int offset) {
+    if (count == 0) {
+        throw std::out_of_range("remove_at_offset on an empty StringDataLoop");
+    }
+
+    *this ^ offset;
+
+    _Node *removed = start;
+    if (count == 1) {
+        start = nullptr;
+    }
+    else {
+        removed->prev->next = removed->next;
+        removed->next->prev = removed->prev;
+        start = removed->next;
+    }
+    count--;
+
+    // the node stays in the arena for the next value added
+    removed->next = free;
+    free = removed;
+    return std::string(removed->data);
+}
+
+// looks value up once, then counts the nodes holding the same copy
+size_t StringDataLoop::count_of(std::string_view value) const {
+    if (!arena) {
+        return 0;
+    }
+    std::string_view kept = arena->find(value);
+    if (kept.data() == nullptr && !value.empty()) {
+        return 0;
+    }
+    size_t matches = 0;
+    _Node *cur_node = start;
+    for (size_t i = 0; i < count; i++) {
+        if (cur_node->data.data() == kept.data() && cur_node->data.size() == kept.size()) {
+            matches++;
+        }
+        cur_node = cur_node->next;
+    }
+    return matches;
+}
+
+// reports the number of distinct values interned in the arena
+size_t StringDataLoop::distinct() const {
+    return arena ? arena->distinct() : 0;
+}
+
+// reports the bytes of the chunks of the arena
+size_t StringDataLoop::arena_bytes() const {
+    return arena ? arena->bytes() : 0;
+}
+
+// links a node holding an interned value before start, reusing a free node if there is one
+void StringDataLoop::append(std::string_view value) {
+    _Node *node = free;
+    if (node) {
+        free = node->next;
+    }
+    else {
+        node = static_cast<_Node *>(nodes.allocate(sizeof(_Node), alignof(_Node)));
+    }
+    new (node) _Node({value, nullptr, nullptr});
+
+    if (count == 0) {
+        node->next = node;
+        node->prev = node;
+        start = node;
+    }
+    else {
+        node->next = start;
+        node->prev = start->prev;
+        start->prev->next = node;
+        start->prev = node;
+    }
+    count++;
+}
+
+// adopts the chunks of rhs and adds its free nodes to ours
+void StringDataLoop::take_nodes(StringDataLoop & rhs) {
+    nodes.adopt(rhs.nodes);
+    while (rhs.free) {
+        _Node *node = rhs.free;
+        rhs.free = node->next;
+        node->next = free;
+        free = node;
+    }
+}
+
+// finds the node offset places from start, walking the shorter way round
+StringDataLoop::_Node * StringDataLoop::at_offset(long offset) const {
+    long steps = offset % static_cast<long>(count);
+    if (steps < 0) {
+        steps += count;
+    }
+    _Node *cur_node = start;
+    if (static_cast<size_t>(steps) <= count / 2) {
+        for (long i = 0; i < steps; i++) {
+            cur_node = cur_node->next;
+        }
+    }
+    else {
+        for (size_t i = steps; i < count; i++) {
+            cur_node = cur_node->prev;
+        }
+    }
+    return cur_node;
+}
+
+// prints the StringDataLoop in the same format as a DataLoop
+std::ostream & operator<<(std::ostream & os, const StringDataLoop & dl) {
+    if (dl.count == 0) {
+        os << ">no values<";
+    }
+    else {
+        os << "-> ";
+        size_t i = 0;
+        for (std::string_view value : dl) {
+            os << value << (++i == dl.count ? " <-" : " <--> ");
+        }
+    }
+    return os;
+}
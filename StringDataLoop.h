@@ -0,0 +1,320 @@
+#ifndef __STRINGDATALOOP_H__
+#define __STRINGDATALOOP_H__
+
+#include <iostream>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * \class BumpAllocator
+ * \brief Memory carved in order from chunks that double in size up to 1 MiB, and given back all at once
+ */
+class BumpAllocator {
+public:
+  explicit BumpAllocator(size_t first_chunk = 4096) : cur(nullptr), left(0), reserved(0), first(first_chunk), next_chunk(first_chunk) { }
+  BumpAllocator(const BumpAllocator &) = delete;
+  BumpAllocator & operator=(const BumpAllocator &) = delete;
+
+  /**
+   * \brief Returns bytes of uninitialized memory aligned to align
+   */
+  void * allocate(size_t bytes, size_t align);
+
+  /**
+   * \brief Takes over the chunks of rhs, whose memory may still be in use, and leaves rhs empty
+   */
+  void adopt(BumpAllocator & rhs);
+
+  /**
+   * \brief Gives back every chunk
+   */
+  void release();
+
+  /// the bytes of every chunk taken so far
+  size_t bytes() const { return reserved; }
+
+private:
+  std::vector<std::unique_ptr<char[]>> chunks;  ///< the memory handed out
+  char *cur;                                    ///< the first free byte of the last chunk
+  size_t left;                                  ///< the free bytes after cur
+  size_t reserved;                              ///< the bytes of every chunk
+  size_t first;                                 ///< the size of the first chunk
+  size_t next_chunk;                            ///< the size of the next chunk
+};
+
+/**
+ * \class StringArena
+ * \brief Keeps one copy of each distinct string, for StringDataLoop
+ *
+ * \detail The copies are carved from a BumpAllocator and only given back when the arena is destroyed. A string is interned by looking it up in a hash set of the copies already made, so equal strings interned in the same arena share one address, and two interned views are equal exactly when their data pointers are. Every member locks the arena, so loops sharing it may intern on different threads.
+ */
+class StringArena {
+public:
+  StringArena() { }
+  StringArena(const StringArena &) = delete;
+  StringArena & operator=(const StringArena &) = delete;
+
+  /**
+   * \brief Returns the copy of value kept in the arena, making it if there is none yet
+   */
+  std::string_view intern(std::string_view value);
+
+  /**
+   * \brief Returns the copy of value kept in the arena, or a view with a null data pointer if there is none
+   */
+  std::string_view find(std::string_view value) const;
+
+  /// the number of distinct strings interned
+  size_t distinct() const;
+
+  /// the bytes of every chunk taken so far
+  size_t bytes() const;
+
+private:
+  mutable std::mutex lock;                        ///< held by every member
+  BumpAllocator memory;                           ///< the memory of the copies
+  std::unordered_set<std::string_view> interned;  ///< a view of each copy kept
+};
+
+/**
+ * \class StringDataLoop
+ * \defgroup StringDataLoop
+ * \brief A dataloop of strings kept once each in an arena
+ *
+ * \detail A TDataLoop<std::string> allocates a node and, for a long value, a string buffer per value, and compares values byte by byte. Here each distinct value is copied once into a StringArena, and the nodes, which are carved from chunks of the loop's own, hold std::string_view handles to the copies, so adding a value allocates nothing once there is room and a repeated value costs no more than a node. Values are read through std::string_view and cannot be changed in place.
+ *
+ * A copy of a loop shares its arena, as do loops that splice from it, so that their values can be compared by address: operator== on loops sharing an arena compares pointers only, and otherwise falls back to bytes where the pointers differ. Only the values are shared. Each loop carves its nodes from its own chunks, reuses the nodes it removes and gives the chunks back on clear, so copying a loop adds nothing to the arena, and loops sharing an arena may be used on different threads. The values stay in the arena until no loop shares it.
+ */
+class StringDataLoop {
+  struct _Node;
+
+public:
+  /**
+   * \class const_iterator
+   * \brief A bidirectional iterator that visits each value once, beginning at start
+   *
+   * \detail Like the DataLoop iterator it counts its steps from start, and end() is start after count steps.
+   */
+  class const_iterator {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::string_view value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::string_view * pointer;
+    typedef const std::string_view & reference;
+
+    const_iterator() : node(nullptr), index(0) { }
+
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+
+    const_iterator & operator++() { node = node->next; index++; return *this; }
+    const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+    const_iterator & operator--() { node = node->prev; index--; return *this; }
+    const_iterator operator--(int) { const_iterator old = *this; --*this; return old; }
+
+    bool operator==(const const_iterator & rhs) const { return index == rhs.index; }
+    bool operator!=(const const_iterator & rhs) const { return !(*this == rhs); }
+
+  private:
+    friend class StringDataLoop;
+    const_iterator(_Node * n, size_t i) : node(n), index(i) { }
+
+    _Node *node;   ///< the node the iterator is at
+    size_t index;  ///< the number of steps taken from start
+  };
+
+  typedef const_iterator iterator;
+
+  /**
+   * \brief The default constructor
+   *
+   * \detail Creates an empty StringDataLoop, which makes its arena when the first value is added
+   */
+  StringDataLoop();
+
+  /**
+   * \brief An alternate constructor
+   *
+   * \detail Creates a StringDataLoop with one node holding value
+   */
+  StringDataLoop(std::string_view value);
+
+  /**
+   * \brief The copy constructor
+   *
+   * \detail The copy shares the arena of rhs, so only the nodes are made.
+   */
+  StringDataLoop(const StringDataLoop & rhs);
+
+  /**
+   * \brief The move constructor
+   *
+   * \detail Takes over the nodes and arena of rhs and leaves rhs empty
+   */
+  StringDataLoop(StringDataLoop && rhs);
+
+  /**
+   * \brief Overloaded operator= to assign a StringDataLoop to another StringDataLoop
+   *
+   * \detail *this is cleared and then shares the arena of rhs.
+   */
+  StringDataLoop & operator=(const StringDataLoop & rhs);
+
+  /**
+   * \brief Overloaded move operator= to hand the nodes of a StringDataLoop to another StringDataLoop
+   */
+  StringDataLoop & operator=(StringDataLoop && rhs);
+
+  /**
+   * \brief Helper function called in destructor
+   *
+   * \detail Gives back the chunks of the nodes, without visiting the nodes one by one, and lets the arena go
+   */
+  void clear();
+
+  /**
+   * \brief The destructor
+   */
+  ~StringDataLoop();
+
+
+  /**
+   * \brief Overloaded operator== to check if two StringDataLoops hold the same values in the same order from start
+   *
+   * \detail Values at the same address are equal. If both loops share an arena, values at different addresses differ, so no byte is compared; otherwise those values are compared byte by byte.
+   */
+  bool operator==(const StringDataLoop & rhs) const;
+
+
+  /**
+   * \brief Overloaded operator+= to add a value to the end of this StringDataLoop
+   *
+   * \detail The value is interned in the arena, which copies it only if it is new, and stored in a reused or newly carved node.
+   */
+  StringDataLoop & operator+=(std::string_view value);
+
+
+  /**
+   * \brief Overloaded operator+ to concatenate copies of two StringDataLoops
+   *
+   * \detail The result shares the arena of *this, into which the values of rhs are interned.
+   */
+  StringDataLoop operator+(const StringDataLoop & rhs) const;
+
+
+  /**
+   * \brief Overloaded operator^ to shift the start position forward for a positive offset and backward for a negative offset
+   */
+  StringDataLoop & operator^(int offset);
+
+
+  /**
+   * \brief Function splice to insert an entire StringDataLoop into this one
+   *
+   * \detail As DataLoop::splice, position 0 inserts rhs before start and makes the start of rhs the new start, and position n inserts rhs after node n, looping around as needed. If rhs shares the arena of *this, or *this is empty, the nodes of rhs are relinked; otherwise its values are interned into the arena of *this. rhs is left empty either way.
+   *
+   * \param[in] rhs A reference to a StringDataLoop object to insert into *this
+   *
+   * \param[in] pos The insertion position
+   *
+   * \return A reference to the updated StringDataLoop object
+   */
+  StringDataLoop & splice(StringDataLoop & rhs, size_t pos);
+
+
+  /**
+   * \brief Function remove_at_offset to shift the start position by offset and remove that node
+   *
+   * \detail As DataLoop::remove_at_offset, start moves on to the node after the one removed, whose node is kept for reuse.
+   *
+   * \return A copy of the removed value
+   *
+   * \throw std::out_of_range if the StringDataLoop is empty
+   */
+  std::string remove_at_offset(int offset);
+
+
+  /**
+   * \brief Function count_of to count the nodes holding value
+   *
+   * \detail value is looked up once in the arena, after which the nodes are compared by address only.
+   */
+  size_t count_of(std::string_view value) const;
+
+
+  /**
+   * \brief Function length to report the number of nodes in *this StringDataLoop
+   */
+  int length() const { return static_cast<int>(count); }
+
+
+  /**
+   * \brief Function distinct to report the number of distinct values in the arena, including those of loops sharing it and removed ones
+   */
+  size_t distinct() const;
+
+
+  /**
+   * \brief Function arena_bytes to report the bytes the arena has taken for values, including those of loops sharing it
+   */
+  size_t arena_bytes() const;
+
+
+  /**
+   * \brief Function node_bytes to report the bytes this StringDataLoop has taken for its nodes
+   */
+  size_t node_bytes() const { return nodes.bytes(); }
+
+
+  /**
+   * \brief Functions begin and end to iterate over the StringDataLoop from the start node
+   */
+  const_iterator begin() const { return const_iterator(start, 0); }
+  const_iterator end() const { return const_iterator(start, count); }
+
+
+  /**
+   * \brief Overloaded output stream operator<< to print the StringDataLoop
+   *
+   * \detail Prints "-> data1 <--> data2 <--> ... <--> datax <-" where data1 is the value in the start node, or ">no values<" if the StringDataLoop is empty.
+   */
+  friend std::ostream & operator<<(std::ostream & os, const StringDataLoop & dl);
+
+private:
+  /// friend StringDataLoopTest struct to allow the test struct access to the private data
+  friend struct StringDataLoopTest;
+
+  /**
+   * \struct _Node
+   * \brief A private structure to represent a node in a StringDataLoop
+   */
+  struct _Node {
+    std::string_view data;  ///< the value, interned in the arena
+    _Node *next;            ///< a pointer to the next node, or the next free node
+    _Node *prev;            ///< a pointer to the previous node
+  };
+
+  /// adds a node holding value, which must already be interned in the arena, to the end of the loop
+  void append(std::string_view value);
+
+  /// takes over the node memory and the free nodes of rhs, whose nodes are being relinked into this loop
+  void take_nodes(StringDataLoop & rhs);
+
+  /// the node shifted offset places from start, walking the shorter way round
+  _Node * at_offset(long offset) const;
+
+  _Node *start;   ///< the start node
+  size_t count;   ///< the number of nodes in the loop
+  _Node *free;    ///< the removed nodes kept for reuse, linked through next
+  BumpAllocator nodes;                 ///< the memory of the nodes, which no other loop shares
+  std::shared_ptr<StringArena> arena;  ///< the arena holding the values, shared with copies
+};
+
+#endif // __STRINGDATALOOP_H__
@@ -0,0 +1,439 @@
+#include "StringDataLoop.h"
+#include "TDataLoop.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::cout;
+using std::endl;
+using std::string;
+
+#ifndef ASSERT
+#include <csignal>  // signal handler 
+#include <cstring>  // memset
+
+char programName[128];
+
+void segFaultHandler(int, siginfo_t*, void* context) {
+  char cmdbuffer[1024];
+  char resultbuffer[128];
+#ifdef __APPLE__
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext->__ss.__rip);
+#else
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+  std::string result = "";
+  FILE* pipe = popen(cmdbuffer, "r");
+  if (!pipe) throw std::runtime_error("popen() failed!");
+  try {
+    while (fgets(resultbuffer, sizeof resultbuffer, pipe) != NULL) {
+      result += resultbuffer;
+    }
+  } catch (...) {
+    pclose(pipe);
+    throw;
+  }
+  pclose(pipe);
+  cout << "Segmentation fault occured in " << result;
+#ifdef __APPLE__
+  ((ucontext_t*)context)->uc_mcontext->__ss.__rip += 2;  // skip the seg fault
+#else
+  ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP] += 2;  // skip the seg fault
+#endif
+}
+
+#define ASSERT(cond) if (!(cond)) { \
+    cout << "failed ASSERT " << #cond << " at line " << __LINE__ << endl; \
+  } else { \
+    cout << __func__ << " - (" << #cond << ")" << " passed!" << endl; \
+  }
+#endif
+
+/**
+ * \struct StringDataLoopTest
+ * \defgroup StringDataLoopTest
+ * \brief Test cases for the StringDataLoop class
+ */
+struct StringDataLoopTest {
+  /// prints any printable object, for comparing the formats of two kinds of loop
+  template<typename Loop>
+  static string text(const Loop & dl) {
+    std::stringstream ss;
+    ss << dl;
+    return ss.str();
+  }
+
+  /**
+   * \brief A test function for the constructors and the arena
+   */
+  static void ConstructorTest() {
+    StringDataLoop empty;
+    ASSERT(empty.start == nullptr);
+    ASSERT(empty.arena == nullptr);
+    ASSERT(text(empty) == ">no values<");
+    ASSERT(empty.arena_bytes() == 0);
+
+    StringDataLoop one("hello");
+    ASSERT(one.length() == 1);
+    ASSERT(one.start->next == one.start);
+    ASSERT(*one.begin() == "hello");
+    ASSERT(one.distinct() == 1);
+
+    // a copy shares the arena, so its values are the same copies
+    StringDataLoop copy(one);
+    ASSERT(copy.arena == one.arena);
+    ASSERT(copy.begin()->data() == one.begin()->data());
+    ASSERT(copy.start != one.start);
+    ASSERT(copy == one);
+
+    StringDataLoop moved(std::move(copy));
+    ASSERT(moved == one);
+    ASSERT(copy.length() == 0);
+    ASSERT(copy.arena == nullptr);
+
+    // the arena outlives the loop it was made for while a copy shares it
+    StringDataLoop *first = new StringDataLoop("kept");
+    StringDataLoop second(*first);
+    delete first;
+    ASSERT(text(second) == "-> kept <-");
+
+    // my tests
+    StringDataLoop a;
+    a = one;
+    a = a;
+    ASSERT(a == one);
+    a = StringDataLoop();
+    ASSERT(a.length() == 0);
+    a.clear();
+    ASSERT(a.arena == nullptr);
+  }
+
+  /**
+   * \brief A test function for operator+=, interning, operator+ and operator<<
+   */
+  static void OperatorPlusGetsTest() {
+    StringDataLoop a;
+    TDataLoop<string> t;
+    const char *words[] = {"to", "be", "or", "not", "to", "be"};
+    for (const char *w : words) {
+      a += w;
+      t += w;
+    }
+    ASSERT(a.length() == 6);
+    ASSERT(text(a) == "-> to <--> be <--> or <--> not <--> to <--> be <-");
+    ASSERT(text(a) == text(t));
+
+    // equal values are stored once and share an address
+    ASSERT(a.distinct() == 4);
+    StringDataLoop::const_iterator it = a.begin();
+    std::string_view to = *it;
+    std::advance(it, 4);
+    ASSERT(it->data() == to.data());
+    ASSERT(a.count_of("to") == 2);
+    ASSERT(a.count_of(string("not")) == 1);
+    ASSERT(a.count_of("question") == 0);
+
+    // the values come from the arena and the nodes from chunks of the loop's own, each growing by chunks
+    size_t bytes = a.arena_bytes();
+    size_t node_bytes = a.node_bytes();
+    ASSERT(bytes == 4096);
+    for (int i = 0; i < 1000; i++) {
+      a += "be";
+    }
+    ASSERT(a.distinct() == 4);
+    ASSERT(a.arena_bytes() == bytes);
+    ASSERT(a.node_bytes() > node_bytes);
+    ASSERT(a.count_of("be") == 1002);
+
+    // a value longer than a chunk gets a chunk of its own
+    StringDataLoop big;
+    big += string(10000, 'z');
+    ASSERT(big.begin()->size() == 10000);
+    ASSERT(big.arena_bytes() >= 10000);
+
+    StringDataLoop b("x");
+    StringDataLoop c = b + a;
+    ASSERT(c.length() == 1007);
+    ASSERT(c.arena == b.arena);
+    ASSERT(c.distinct() == 5);
+    ASSERT(text(StringDataLoop() + StringDataLoop()) == ">no values<");
+
+    // my tests
+    StringDataLoop e;
+    e += "";
+    e += string();
+    ASSERT(e.distinct() == 1);
+    ASSERT(e.count_of("") == 2);
+    ASSERT(text(e) == "->  <-->  <-");
+    StringDataLoop::const_iterator cit = e.end();
+    --cit;
+    ASSERT(cit != e.begin());
+    ASSERT(--cit == e.begin());
+  }
+
+  /**
+   * \brief A test function for operator==
+   */
+  static void OperatorEqualTest() {
+    StringDataLoop a;
+    a += "alpha";
+    a += "beta";
+    StringDataLoop b(a);
+    ASSERT(a == b);
+    b ^ 1;
+    ASSERT(!(a == b));
+    b ^ 1;
+    ASSERT(a == b);
+
+    // loops with separate arenas fall back to comparing bytes
+    StringDataLoop c;
+    c += "alpha";
+    c += "beta";
+    ASSERT(c.arena != a.arena);
+    ASSERT(a == c);
+    c.remove_at_offset(1);
+    c += "gamma";
+    ASSERT(!(a == c));
+
+    // within a shared arena different addresses mean different values
+    StringDataLoop d(a);
+    d.remove_at_offset(1);
+    d += "delta";
+    ASSERT(d.arena == a.arena);
+    ASSERT(!(a == d));
+
+    // my tests
+    ASSERT(StringDataLoop() == StringDataLoop());
+    ASSERT(!(a == StringDataLoop("alpha")));
+  }
+
+  /**
+   * \brief A test function for operator^
+   */
+  static void OperatorShiftTest() {
+    StringDataLoop a;
+    TDataLoop<string> t;
+    for (int i = 1; i <= 5; i++) {
+      a += std::to_string(i);
+      t += std::to_string(i);
+    }
+
+    int offsets[] = {2, -3, 11, -12, 0, 4, -1, 8};
+    bool same = true;
+    for (int offset : offsets) {
+      a ^ offset;
+      t ^ offset;
+      same = same && text(a) == text(t);
+    }
+    ASSERT(same);
+
+    // my tests
+    StringDataLoop empty;
+    empty ^ 3;
+    ASSERT(empty.length() == 0);
+  }
+
+  /**
+   * \brief A test function for splice
+   */
+  static void FunctionSpliceTest() {
+    // the same positions as DataLoop, including those past the end, with shared and separate arenas
+    bool same = true;
+    for (int shared = 0; shared < 2; shared++) {
+      for (size_t pos = 0; pos < 9; pos++) {
+        StringDataLoop a;
+        TDataLoop<string> ta;
+        for (int i = 1; i <= 4; i++) {
+          a += std::to_string(i);
+          ta += std::to_string(i);
+        }
+        StringDataLoop b;
+        if (shared) {
+          b = a;
+          b.clear();
+          b.arena = a.arena;
+        }
+        TDataLoop<string> tb;
+        for (int i = 7; i <= 9; i++) {
+          b += std::to_string(i);
+          tb += std::to_string(i);
+        }
+        a.splice(b, pos);
+        ta.splice(tb, pos);
+        same = same && text(a) == text(ta) && b.length() == 0 && b.start == nullptr;
+      }
+    }
+    ASSERT(same);
+
+    // a shared arena lets the nodes be relinked, not copied
+    StringDataLoop a("a");
+    StringDataLoop b(a);
+    b += "b";
+    StringDataLoop::_Node *node = b.start->next;
+    a.splice(b, 1);
+    ASSERT(a.start->next->next == node);
+    ASSERT(text(a) == "-> a <--> a <--> b <-");
+
+    // values from another arena are interned into ours, reusing free nodes
+    StringDataLoop c;
+    c += "b";
+    c += "c";
+    a.remove_at_offset(0);
+    StringDataLoop::_Node *freed = a.free;
+    ASSERT(freed != nullptr);
+    a.splice(c, 0);
+    ASSERT(text(a) == "-> b <--> c <--> a <--> b <-");
+    ASSERT(a.start == freed);
+    ASSERT(a.distinct() == 3);
+    ASSERT(a.count_of("b") == 2);
+
+    // an empty loop takes over the nodes and their arena
+    StringDataLoop empty;
+    empty.splice(a, 3);
+    ASSERT(text(empty) == "-> b <--> c <--> a <--> b <-");
+    ASSERT(a.length() == 0);
+
+    // my tests
+    empty.splice(empty, 1);
+    empty.splice(a, 0);
+    ASSERT(empty.length() == 4);
+  }
+
+  /**
+   * \brief A test function for remove_at_offset
+   */
+  static void FunctionRemoveTest() {
+    StringDataLoop a;
+    for (int i = 1; i <= 6; i++) {
+      a += std::to_string(i);
+    }
+    ASSERT(a.remove_at_offset(2) == "3");
+    ASSERT(text(a) == "-> 4 <--> 5 <--> 6 <--> 1 <--> 2 <-");
+
+    // the freed node is used again, and the value is still interned
+    StringDataLoop::_Node *freed = a.free;
+    size_t bytes = a.arena_bytes();
+    a += "3";
+    ASSERT(a.start->prev == freed);
+    ASSERT(a.free == nullptr);
+    ASSERT(a.arena_bytes() == bytes);
+    ASSERT(a.distinct() == 6);
+
+    bool threw = false;
+    try {
+      StringDataLoop().remove_at_offset(0);
+    }
+    catch (const std::out_of_range &) {
+      threw = true;
+    }
+    ASSERT(threw);
+
+    // my tests
+    // the removed value is returned as a string of its own, which outlives the arena, while the copy stays interned
+    StringDataLoop s;
+    s += "first";
+    s += "last";
+    string last = s.remove_at_offset(-1);
+    ASSERT(s.count_of("last") == 0);
+    ASSERT(s.distinct() == 2);
+    s.clear();
+    ASSERT(last == "last");
+    ASSERT(s.node_bytes() == 0);
+  }
+
+  /**
+   * \brief A test function for loops sharing an arena
+   */
+  static void SharedArenaTest() {
+    StringDataLoop a;
+    a += "red";
+    a += "green";
+    a += "blue";
+
+    // temporary copies make nodes of their own, so the arena does not grow, and give them back when destroyed
+    size_t bytes = a.arena_bytes();
+    bool own_nodes = true;
+    for (int i = 0; i < 1000; i++) {
+      StringDataLoop copy(a);
+      own_nodes = own_nodes && copy.node_bytes() > 0 && copy.start != a.start;
+    }
+    ASSERT(own_nodes);
+    ASSERT(a.arena_bytes() == bytes);
+    StringDataLoop copy(a);
+    copy.clear();
+    ASSERT(copy.node_bytes() == 0);
+
+    // a value interned by one loop is already kept for every loop sharing the arena
+    StringDataLoop b(a);
+    b += "cyan";
+    ASSERT(a.distinct() == 4);
+    ASSERT(a.count_of("cyan") == 0);
+    a += "cyan";
+    ASSERT(std::next(a.begin(), 3)->data() == std::next(b.begin(), 3)->data());
+    ASSERT(a == b);
+
+    // relinked nodes bring their memory along, and stay valid after the loop they came from is gone
+    StringDataLoop *c = new StringDataLoop(a);
+    *c += "magenta";
+    c->remove_at_offset(0);
+    size_t taken = c->node_bytes();
+    b.splice(*c, 0);
+    delete c;
+    ASSERT(b.node_bytes() > taken);
+    ASSERT(text(b) == "-> green <--> blue <--> cyan <--> magenta <--> red <--> green <--> blue <--> cyan <-");
+
+    // copies sharing an arena may intern values on different threads at once
+    std::vector<StringDataLoop> copies(4, a);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < copies.size(); t++) {
+      threads.push_back(std::thread([&copies, t]() {
+        for (int i = 0; i < 1000; i++) {
+          copies[t] += std::to_string(i % 500);
+        }
+      }));
+    }
+    for (std::thread & t : threads) {
+      t.join();
+    }
+    bool interned_once = true;
+    for (size_t t = 1; t < copies.size(); t++) {
+      interned_once = interned_once && copies[t] == copies[0] && copies[t].count_of("7") == 2;
+    }
+    ASSERT(interned_once);
+    ASSERT(a.distinct() == 5 + 500);
+
+    // my tests
+    // loops with separate arenas keep separate copies of equal values
+    StringDataLoop d("red");
+    ASSERT(d.begin()->data() != a.begin()->data());
+    ASSERT(d.distinct() == 1);
+    d.splice(a, 1);
+    ASSERT(d.distinct() == 4);
+    ASSERT(d.arena != copies[0].arena);
+  }
+};
+
+int main(int, char* argv[]) {
+  cout << "Testing StringDataLoop" << endl;
+  // register a seg fault handler
+  sprintf(programName, "%s", argv[0]);
+  struct sigaction signalAction;
+  memset(&signalAction, 0, sizeof(struct sigaction));
+  signalAction.sa_flags = SA_SIGINFO;
+  signalAction.sa_sigaction = segFaultHandler;
+  sigaction(SIGSEGV, &signalAction, NULL);
+
+  StringDataLoopTest::ConstructorTest();   // string_view
+  StringDataLoopTest::OperatorPlusGetsTest();   // string_view, string
+  StringDataLoopTest::OperatorEqualTest();   // string_view
+  StringDataLoopTest::OperatorShiftTest();   // string_view, string
+  StringDataLoopTest::FunctionSpliceTest();   // string_view, string
+  StringDataLoopTest::FunctionRemoveTest();   // string_view
+  StringDataLoopTest::SharedArenaTest();   // string_view, string
+  
+  return 0;
+}
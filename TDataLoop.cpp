@@ -0,0 +1,8 @@
+#include "TDataLoop.h"
+
+// explicit instantiations of the common loops, which TDataLoop.h declares extern so that no other file compiles them;
+// member templates such as sort(Compare) and radix_sort are still instantiated where they are used
+template class TDataLoop<int>;
+template class TDataLoop<double>;
+template class TDataLoop<char>;
+template class TDataLoop<std::string>;
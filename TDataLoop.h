@@ -2,11 +2,251 @@
 #define T_DATA_LOOP_H
 
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "LoopMemory.h"
+#include "LoopReclaimer.h"
 
-template<typename T>
+/**
+ * \struct TDataLoopSlots
+ * \brief Raw inline storage for up to N nodes of a TDataLoop
+ *
+ * \detail Each slot is Size bytes aligned to Align. A bitmask records which slots currently hold a node, so N is limited to 64.
+ */
+template<size_t Size, size_t Align, size_t N>
+struct TDataLoopSlots {
+  static_assert(N <= 64, "TDataLoop supports at most 64 inline nodes");
+
+  typename std::aligned_storage<Size, Align>::type raw[N];  ///< the slot storage
+  unsigned long long used = 0;                              ///< bit i is set while slot i holds a node
+
+  /// returns a free slot, or nullptr if all N are in use
+  void * acquire() {
+    for (size_t i = 0; i < N; i++) {
+      if (!(used & (1ULL << i))) {
+        used |= 1ULL << i;
+        return &raw[i];
+      }
+    }
+    return nullptr;
+  }
+
+  /// returns a slot holding a node, or nullptr if none do
+  void * first_used() {
+    for (size_t i = 0; i < N; i++) {
+      if (used & (1ULL << i)) {
+        return &raw[i];
+      }
+    }
+    return nullptr;
+  }
+
+  /// marks the slot at p as free again
+  void release(const void * p) {
+    used &= ~(1ULL << index(p));
+  }
+
+  /// true if p points into this slot storage
+  bool owns(const void * p) const {
+    std::less<const void *> before;
+    return !before(p, raw) && before(p, raw + N);
+  }
+
+  /// the slot number of p, which must be owned by this storage
+  size_t index(const void * p) const {
+    return static_cast<const typename std::aligned_storage<Size, Align>::type *>(p) - raw;
+  }
+
+  /// the number of slots holding a node
+  size_t in_use() const {
+    size_t n = 0;
+    for (unsigned long long bits = used; bits; bits &= bits - 1) {
+      n++;
+    }
+    return n;
+  }
+
+  /// the bytes of the slots holding no node
+  size_t free_bytes() const { return (N - in_use()) * sizeof(raw[0]); }
+};
+
+/**
+ * \struct TDataLoopSlots
+ * \brief A TDataLoop with no inline capacity keeps every node on the heap
+ */
+template<size_t Size, size_t Align>
+struct TDataLoopSlots<Size, Align, 0> {
+  void * acquire() { return nullptr; }
+  void * first_used() { return nullptr; }
+  void release(const void *) { }
+  bool owns(const void *) const { return false; }
+  size_t in_use() const { return 0; }
+  size_t free_bytes() const { return 0; }
+};
+
+template<typename T, size_t N> class TDataLoopWindow;
+
+/**
+ * \class TDataLoop
+ * \brief A dataloop of any value type
+ *
+ * \detail The first N nodes live inside the TDataLoop object itself, in a fixed array of slots, so a loop that never holds more than N values makes no heap allocations. Nodes beyond N are allocated on the heap, and a freed inline slot is reused before the heap. With the default N of 0 every node is on the heap. TDataLoop<int>, which is DataLoop, TDataLoop<double>, TDataLoop<char> and TDataLoop<std::string> are instantiated once, in TDataLoop.cpp, so a file using them only compiles the members it inlines.
+ */
+template<typename T, size_t N = 0>
 
 class TDataLoop {
+  struct _Node;
+
     public:
+  /**
+   * \class handle
+   * \brief A stable reference to one node of a DataLoop
+   *
+   * \detail Like a std::list iterator, a handle stays valid while other nodes are added, removed or spliced, and only becomes invalid when its own node is erased or the DataLoop is cleared. A default-constructed handle refers to no node.
+   */
+  class handle {
+  public:
+    handle() : node(nullptr) { }
+
+    T & operator*() const { return node->data; }
+    T * operator->() const { return &node->data; }
+
+    bool operator==(const handle & rhs) const { return node == rhs.node; }
+    bool operator!=(const handle & rhs) const { return node != rhs.node; }
+
+    /// true if the handle refers to a node
+    explicit operator bool() const { return node != nullptr; }
+
+  private:
+    friend class TDataLoop;
+    explicit handle(_Node * n) : node(n) { }
+
+    _Node *node;  ///< the referenced node
+  };
+
+  /**
+   * \class basic_iterator
+   * \brief A bidirectional iterator that visits each node once, beginning at start
+   *
+   * \detail Since the loop has no last node, the iterator also counts its steps from start, and end() is start after count steps. It follows the direction of the DataLoop it came from, so a reversed DataLoop is visited in reversed order.
+   */
+  template<bool Const>
+  class basic_iterator {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T, T>::type * pointer;
+    typedef typename std::conditional<Const, const T, T>::type & reference;
+
+    basic_iterator() : node(nullptr), index(0), reversed(false) { }
+
+    /// copies an iterator, or converts an iterator to a const_iterator
+    basic_iterator(const basic_iterator<false> & it) : node(it.node), index(it.index), reversed(it.reversed) { }
+
+    reference operator*() const { return node->data; }
+    pointer operator->() const { return &node->data; }
+
+    basic_iterator & operator++() { node = reversed ? node->prev : node->next; index++; return *this; }
+    basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; }
+    basic_iterator & operator--() { node = reversed ? node->next : node->prev; index--; return *this; }
+    basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; }
+
+    bool operator==(const basic_iterator & rhs) const { return node == rhs.node && index == rhs.index; }
+    bool operator!=(const basic_iterator & rhs) const { return !(*this == rhs); }
+
+    /// the handle of the node this iterator is at
+    handle to_handle() const { return handle(node); }
+
+  private:
+    friend class TDataLoop;
+    template<bool> friend class basic_iterator;
+    basic_iterator(_Node * n, size_t i, bool rev) : node(n), index(i), reversed(rev) { }
+
+    _Node *node;    ///< the node the iterator is at
+    size_t index;   ///< the number of steps taken from start
+    bool reversed;  ///< whether forward steps follow the prev pointers
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  /**
+   * \class LoopView
+   * \brief A read-only cursor over a DataLoop with its own start position
+   *
+   * \detail A view shares the nodes of its DataLoop instead of copying them, so several consumers can each rotate their own view with operator^ and walk the loop from their own start, while the DataLoop and its start stay as they are. Creating a view is O(1). The view follows the order of the DataLoop, including a reversal made after the view was created, and sees values added or removed elsewhere in the loop. Like a handle, it becomes invalid if the node at its start is removed or the DataLoop is destroyed. A view of an empty DataLoop starts wherever the DataLoop starts.
+   */
+  class LoopView {
+  public:
+    LoopView() : loop(nullptr), node(nullptr) { }
+
+    /// moves the start of the view forward for a positive offset and backward for a negative one, the shorter way round
+    LoopView & operator^(int offset);
+
+    /// the number of values in the view, that is in its DataLoop
+    int length() const { return static_cast<int>(loop->count); }
+
+    /// a handle to the node at the start of the view
+    handle start_handle() const { return handle(first()); }
+
+    const_iterator begin() const { return const_iterator(first(), 0, loop->reversed); }
+    const_iterator end() const { return const_iterator(first(), loop->count, loop->reversed); }
+
+    /// true if the view and rhs hold equal values in the same order, each from its own start
+    bool operator==(const TDataLoop & rhs) const {
+      return loop->count == rhs.count && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const TDataLoop & rhs) const { return !(*this == rhs); }
+
+    /// true if the two views hold equal values in the same order, each from its own start
+    bool operator==(const LoopView & rhs) const {
+      return loop->count == rhs.loop->count && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const LoopView & rhs) const { return !(*this == rhs); }
+
+    friend bool operator==(const TDataLoop & lhs, const LoopView & rhs) { return rhs == lhs; }
+    friend bool operator!=(const TDataLoop & lhs, const LoopView & rhs) { return rhs != lhs; }
+
+    /// prints the view in the same format as the DataLoop, beginning at the start of the view
+    friend std::ostream & operator<<(std::ostream & os, const LoopView & view) {
+      int n = view.length();
+      if (n == 0) {
+        return os << ">no values<";
+      }
+      os << "-> ";
+      const_iterator it = view.begin();
+      for (int i = 0; i < n; i++, ++it) {
+        os << *it << (i == n - 1 ? " <-" : " <--> ");
+      }
+      return os;
+    }
+
+  private:
+    friend class TDataLoop;
+    LoopView(const TDataLoop * l, _Node * n) : loop(l), node(n) { }
+
+    /// the start node of the view, which for a view made of an empty loop is the start of the loop
+    _Node * first() const { return node ? node : loop->start; }
+
+    const TDataLoop *loop;  ///< the viewed DataLoop
+    _Node *node;            ///< the start node of the view, or nullptr to follow the start of the loop
+  };
+
   /**
    * \brief The default constructor
    *
@@ -31,6 +271,15 @@ class TDataLoop {
    * \param[in] rhs A constant reference to the function input DataLoop object
    */ 
   TDataLoop(const TDataLoop & rhs);
+
+  /**
+   * \brief The move constructor
+   *
+   * \detail The move constructor takes over the nodes of the parameter DataLoop (rhs) without copying them, leaving rhs empty. Nodes held in the inline slots of rhs are moved into the inline slots of the new DataLoop, so handles to them become invalid.
+   *
+   * \param[in] rhs A reference to the DataLoop object to take the nodes from
+   */
+  TDataLoop(TDataLoop && rhs);
   
   /**
    * \brief Overloaded operator= to assign a DataLoop to another DataLoop
@@ -45,6 +294,17 @@ class TDataLoop {
    */
   TDataLoop & operator=(const TDataLoop & rhs); 
 
+  /**
+   * \brief Overloaded move operator= to hand the nodes of a DataLoop to another DataLoop
+   *
+   * \detail The current DataLoop is cleared and then takes over the nodes of rhs without copying them, leaving rhs empty. Nodes held in the inline slots of rhs are moved into the inline slots of *this, so handles to them become invalid.
+   *
+   * \param[in] rhs A reference to the DataLoop object to take the nodes from
+   *
+   * \return A reference to the updated DataLoop object
+   */
+  TDataLoop & operator=(TDataLoop && rhs);
+
 
    /**
    * \brief Helper function called in destructor
@@ -116,53 +376,1013 @@ class TDataLoop {
    *
    * \param[in] pos The insertion position 
    *
+   * \note The nodes of rhs are relinked into *this rather than copied, so handles to them stay valid, except that inline nodes of rhs move into free inline slots of *this or onto the heap.
+   *
    * \return A reference to the updated DataLoop object 
    */
   TDataLoop & splice(TDataLoop & rhs, size_t pos);
-  
+
+
+  /**
+   * \brief Function splice_many to insert several DataLoops into this one in a single pass
+   *
+   * \detail Each entry gives a DataLoop and an insertion position with the same meaning as in splice, but every position refers to *this as it was before the call, not as it is after the earlier entries were inserted. The entries are sorted by position, the loop is walked once from start, and each DataLoop is relinked in as a whole. Entries with the same position are inserted in the order given, and a DataLoop at position 0 becomes the new start as in splice. If *this is empty, the DataLoops are joined in order of position. Every DataLoop in the list is left empty. Entries that are null, empty or *this itself are skipped, and a DataLoop listed more than once is inserted at the first of its positions along the loop.
+   *
+   * \param[in] entries Pairs of a DataLoop to insert and its insertion position
+   *
+   * \return A reference to the updated DataLoop object
+   */
+  TDataLoop & splice_many(const std::vector<std::pair<TDataLoop *, size_t>> & entries);
+
+
+  /**
+   * \brief Function remove_at_offset to shift the start position and remove the node found there
+   *
+   * \detail This function shifts the start position by offset exactly as operator^ does, removes that node from the DataLoop and makes the node after it the new start. It is the single step of a round-robin elimination.
+   *
+   * \param[in] offset The number of nodes/positions to move the start position before removing, positive for forward shifting, negative for backward motion
+   *
+   * \return The value held by the removed node
+   *
+   * \throw std::out_of_range if the DataLoop is empty
+   */
+  T remove_at_offset(int offset);
+
+
+  /**
+   * \brief Function eliminate_every to remove every node in round-robin (Josephus) order
+   *
+   * \detail Repeatedly applies remove_at_offset(k) until the DataLoop is empty, passing each removed value to visit in removal order. So k = 0 removes the nodes in loop order, and k = 1 removes every second node. Rather than walking k nodes per removal, the positions of the remaining nodes are kept in a Fenwick tree, so the whole elimination takes O(n log n) time for any k. If visit throws, the remaining nodes are freed and the DataLoop is left empty.
+   *
+   * \param[in] k The offset applied before each removal
+   *
+   * \param[in] visit A function called with each removed value, in removal order
+   */
+  void eliminate_every(int k, const std::function<void(const T &)> & visit);
+
+
+  /**
+   * \brief Function eliminate_every to remove every node in round-robin (Josephus) order
+   *
+   * \detail Same as the overload taking a function, but collects the removed values.
+   *
+   * \param[in] k The offset applied before each removal
+   *
+   * \return The removed values in removal order
+   */
+  std::vector<T> eliminate_every(int k);
+
 
   /**
    * \brief Function length to report the number of nodes in *this DataLoop
    *
    * \return The number of nodes
    */
-  int length() { return count; }
+  int length() const { return count; }
 
 
   /**
-   * \brief Overloaded output stream operator<< to print the DataLoop
+   * \brief Functions begin and end to iterate over the DataLoop from the start node
    *
-   * \detail This operator prints the input DataLoop (dl) to the ostream (os) in the format 
-   * "-> data1 <--> data2 <--> ... <--> datax <-" where data1 is the value in the start node
-   *   e.g. if we have a DataLoop with three elements 32, 12, 20 starting at 12
-   *        it will print "-> 12 <--> 20 <--> 32 <-"
-   *   If the DataLoop is empty, it prints ">no values<".
+   * \return An iterator at the start node, or one past the last node
+   */
+  iterator begin() { return iterator(start, 0, reversed); }
+  iterator end() { return iterator(start, count, reversed); }
+  const_iterator begin() const { return const_iterator(start, 0, reversed); }
+  const_iterator end() const { return const_iterator(start, count, reversed); }
+
+
+  /**
+   * \brief Function view to make a LoopView over this DataLoop
    *
-   * \param[in] os A reference to the output stream object
-   * \param[in] q A constant reference to the DataLoop object to be printed
+   * \detail The view shares the nodes of this DataLoop and starts offset positions from start, as operator^ would count them, without moving start or copying any value. With an offset of 0 this is O(1).
    *
-   * \return A reference to the output stream object
+   * \param[in] offset The position of the start of the view, forward for a positive value and backward for a negative one
+   *
+   * \return A view starting at that position
    */
-  template<typename U>
-  friend std::ostream & operator<<(std::ostream & os, const TDataLoop<U> & dl);
-  
-private:
-  /// friend DataLoopTest struct to allow the test struct access to the private data
-  friend struct TDataLoopTest;
-  
+  LoopView view(int offset = 0) const;
+
+
   /**
-   * \struct _Node
-   * \brief A private structure to represent a node in a DataLoop
+   * \brief Function start_handle to get a handle to the start node
+   *
+   * \return A handle to the start node, or an empty handle if the DataLoop is empty
    */
-  struct _Node {
-    T data;     ///< Integer node data
-    _Node *next;  ///< A pointer to the next node
-    _Node *prev;  ///< A pointer to the previous node
-  };
+  handle start_handle() const { return handle(start); }
 
-  _Node* start;   ///< a pointer to the starting node position in the DataLoop
-  size_t count;   ///< the count of how many nodes/values are in the structure
-};
 
-#include "TDataLoop.inc"
+  /**
+   * \brief Function handle_at to get a handle to the node pos positions after start
+   *
+   * \detail Positions past the last node loop around as much as necessary. This walks the shorter way round to the node.
+   *
+   * \param[in] pos The position of the node, where 0 is the start node
+   *
+   * \return A handle to the node, or an empty handle if the DataLoop is empty
+   */
+  handle handle_at(size_t pos) const;
+
+
+  /**
+   * \brief Functions next and prev to step a handle to the neighbouring node
+   *
+   * \param[in] pos A handle to a node of this DataLoop
+   *
+   * \return A handle to the node after (next) or before (prev) pos
+   */
+  handle next(handle pos) const { return handle(forward(pos.node)); }
+  handle prev(handle pos) const { return handle(backward(pos.node)); }
+
+
+  /**
+   * \brief Function insert_before to add a value immediately before a node
+   *
+   * \detail This is an O(1) pointer operation and start is not changed, so inserting before the start node adds the value at the end of the DataLoop just as operator+= does.
+   *
+   * \param[in] pos A handle to a node of this DataLoop
+   *
+   * \param[in] value The value to add
+   *
+   * \return A handle to the new node
+   */
+  handle insert_before(handle pos, const T & value);
+
+
+  /**
+   * \brief Function insert_after to add a value immediately after a node
+   *
+   * \detail This is an O(1) pointer operation and start is not changed.
+   *
+   * \param[in] pos A handle to a node of this DataLoop
+   *
+   * \param[in] value The value to add
+   *
+   * \return A handle to the new node
+   */
+  handle insert_after(handle pos, const T & value);
+
+
+  /**
+   * \brief Function erase to remove one node from the DataLoop
+   *
+   * \detail This is an O(1) pointer operation. If pos is the start node, the node after it becomes the new start. Only handles to the erased node become invalid.
+   *
+   * \param[in] pos A handle to a node of this DataLoop
+   *
+   * \return A handle to the node that followed pos, or an empty handle if the DataLoop is now empty
+   */
+  handle erase(handle pos);
+
+
+  /**
+   * \brief Function move_to_start to move one node to the start position
+   *
+   * \detail The node is taken out of its current position and relinked immediately before the old start node, then becomes the new start. The order of the other nodes does not change. This is an O(1) pointer operation and no handle is invalidated.
+   *
+   * \param[in] pos A handle to a node of this DataLoop
+   */
+  void move_to_start(handle pos);
+
+
+  /**
+   * \brief Function split to detach a run of nodes into a new DataLoop
+   *
+   * \detail This function is the inverse of splice. It detaches len nodes, beginning with the node pos positions after start (looping around as much as necessary), by relinking pointers; no value is copied. The first detached node is the start of the returned DataLoop. If the run contains the start node of *this, the node after the run becomes the new start. A len of count or more detaches every node, and a len of 0 returns an empty DataLoop. Inline nodes of *this are first moved to the heap, since they cannot leave the object.
+   *
+   * \param[in] pos The position of the first node to detach, where 0 is the start node
+   *
+   * \param[in] len The number of nodes to detach
+   *
+   * \return A DataLoop holding the detached nodes
+   */
+  TDataLoop split(size_t pos, size_t len);
+
+
+  /**
+   * \brief Function split to detach the nodes from first to last into a new DataLoop
+   *
+   * \detail Detaches first, last and every node between them going forward, by relinking pointers; no value is copied. first is the start of the returned DataLoop. If the run contains the start node of *this, the node after the run becomes the new start. The relinking is O(1), but the run is walked once to count it. Handles stay valid, except that inline nodes in the run are moved to the heap.
+   *
+   * \param[in] first A handle to the first node to detach
+   *
+   * \param[in] last A handle to the last node to detach, which may be first
+   *
+   * \return A DataLoop holding the detached nodes
+   */
+  TDataLoop split(handle first, handle last);
+
+
+  /**
+   * \brief Function split_into to cut the DataLoop into k nearly equal DataLoops
+   *
+   * \detail Cuts the DataLoop into k consecutive runs, beginning at start, by relinking pointers. The lengths differ by at most one, with the longer runs first, so some are empty when k is larger than count. This DataLoop is left empty.
+   *
+   * \param[in] k The number of DataLoops to produce
+   *
+   * \return The k DataLoops, in loop order
+   *
+   * \throw std::invalid_argument if k is 0
+   */
+  std::vector<TDataLoop> split_into(size_t k);
+
+
+  /**
+   * \brief Function reverse to reverse the order of the DataLoop in O(1)
+   *
+   * \detail Rather than relinking nodes, this flips a direction flag that every operation respects, so after reverse() next steps follow the prev pointers and vice versa. The start node does not change, so a DataLoop printed as "-> 1 <--> 2 <--> 3 <-" prints as "-> 1 <--> 3 <--> 2 <-" once reversed. Handles stay valid. Splicing loops whose directions differ relinks the nodes of rhs to match *this, which is O(count of rhs).
+   */
+  void reverse();
+
+
+  /**
+   * \brief Function is_reversed to report whether the direction flag is set
+   *
+   * \return true if the order of the DataLoop runs along the prev pointers
+   */
+  bool is_reversed() const { return reversed; }
+
+
+  /**
+   * \brief Function materialize_reverse to make a reversed order physical
+   *
+   * \detail If the direction flag is set, this swaps the next and prev pointers of every node and clears the flag, so the nodes are physically linked in their current order. The order of the DataLoop does not change. Otherwise it does nothing.
+   */
+  void materialize_reverse();
+
+
+  /**
+   * \brief Function set_capacity to bound the number of values the DataLoop holds
+   *
+   * \detail A bounded DataLoop keeps the most recent cap values, like a ring buffer. Since operator+= adds at the end, the start node holds the oldest value. Once the DataLoop is full, operator+= overwrites the value in the start node and moves start to the next node, so it neither allocates nor frees. Other operations that add nodes (insert_before, insert_after, splice and splice_many) remove nodes from start until the DataLoop is back within its capacity. If the DataLoop already holds more than cap values, the oldest are removed now. Each overwritten or removed value is passed to on_evict first. Copies keep the capacity and on_evict. A cap of 0 removes the bound.
+   *
+   * \param[in] cap The greatest number of values to hold, or 0 for no bound
+   *
+   * \param[in] on_evict A function called with each value that is overwritten or removed to stay within the capacity, or nullptr
+   */
+  void set_capacity(size_t cap, const std::function<void(const T &)> & on_evict = nullptr);
+
+
+  /**
+   * \brief Function capacity to report the bound set by set_capacity
+   *
+   * \return The greatest number of values the DataLoop holds, or 0 if it is not bounded
+   */
+  size_t capacity() const { return ext ? ext->cap : 0; }
+
+
+  /**
+   * \brief Function sort to put the values in ascending order
+   *
+   * \detail The nodes are sorted by relinking their pointers with a bottom-up merge sort, so no value moves between nodes and every handle stays valid. The sort is stable and takes O(n log n) comparisons. The smallest value becomes the start node, and the direction flag is cleared. For arithmetic T the values are first copied, each paired with its node, into a temporary array that is sorted with std::stable_sort, and the nodes are then relinked in the order of the array. Comparing values held in the array avoids a cache miss per comparison, so on long loops this is several times quicker than merging along the next pointers, but it is not free: on loops of millions of ints it is about a fifth slower than copying the values out to a std::vector, sorting that and rebuilding the loop, which sort cannot do without invalidating handles.
+   *
+   * \param[in] comp A strict weak ordering, called as comp(a, b) to ask whether a comes before b
+   */
+  template<typename Compare>
+  void sort(Compare comp);
+
+
+  /**
+   * \brief Function sort to put the values in ascending order using operator<
+   */
+  void sort() { sort(std::less<T>()); }
+
+
+  /**
+   * \brief Function parallel_sort to sort the values using several threads
+   *
+   * \detail The loop is cut into one run per thread. Each run is sorted on its own thread, and then the runs are merged in pairs, also in parallel. The result is the same as sort(comp), so it is stable and keeps every handle valid. comp must be safe to call from several threads at once. Loops too short to gain from threads are sorted on the calling thread.
+   *
+   * \param[in] comp A strict weak ordering, called as comp(a, b) to ask whether a comes before b
+   *
+   * \param[in] threads The number of threads to use, or 0 for std::thread::hardware_concurrency
+   */
+  template<typename Compare>
+  void parallel_sort(Compare comp, unsigned threads = 0);
+
+
+  /**
+   * \brief Function parallel_sort to sort the values with operator< using several threads
+   */
+  void parallel_sort() { parallel_sort(std::less<T>()); }
+
+
+  /**
+   * \brief Function merge to move every node of a sorted DataLoop into this sorted DataLoop
+   *
+   * \detail Both DataLoops must already be sorted by comp. Their nodes are interleaved by relinking in O(n+m), so no value is copied and handles to the nodes of rhs now refer to nodes of *this. On equal values the nodes of *this come first. Afterwards rhs is empty and the smallest value is the start node. Inline nodes of rhs are moved into free inline slots of *this or onto the heap first, since they cannot leave rhs. A bounded DataLoop then drops its oldest values, from the new start, down to its capacity.
+   *
+   * \param[in] rhs A DataLoop sorted by comp
+   *
+   * \param[in] comp The strict weak ordering both DataLoops are sorted by
+   */
+  template<typename Compare>
+  void merge(TDataLoop & rhs, Compare comp);
+
+
+  /**
+   * \brief Function merge to move every node of a DataLoop sorted by operator< into this one
+   */
+  void merge(TDataLoop & rhs) { merge(rhs, std::less<T>()); }
+
+
+  /**
+   * \brief Function radix_sort to put integral values in ascending order
+   *
+   * \detail An LSD radix sort: for each byte of the values, least significant first, the nodes are distributed by relinking into 256 bucket chains, which are then joined in O(1) each. Bytes that are the same in every value are skipped. No memory is allocated for nodes and no value moves between nodes, so every handle stays valid. The sort is stable, takes O(n) per pass, and gives the same order as sort(). The smallest value becomes the start node, and the direction flag is cleared. Only available when T is an integral type other than bool.
+   */
+  template<typename U = T>
+  typename std::enable_if<std::is_integral<U>::value && !std::is_same<U, bool>::value>::type radix_sort();
+
+
+  /**
+   * \brief Function partition_into to scatter the nodes into k DataLoops
+   *
+   * \detail Each node is relinked, in a single pass, onto the end of the DataLoop numbered key(value), so every returned DataLoop keeps the relative order the values had in *this. No value is copied and handles stay valid, now referring to nodes of the returned DataLoops. key is called once per value, in order, before any node moves, so a key of k or more throws and leaves *this unchanged. Afterwards *this is empty. Inline nodes are first moved to the heap, since they cannot leave the object.
+   *
+   * \param[in] k The number of DataLoops to return
+   *
+   * \param[in] key A function giving the number, below k, of the DataLoop a value goes to
+   *
+   * \return k DataLoops, some of which may be empty
+   *
+   * \throw std::invalid_argument if k is 0
+   *
+   * \throw std::out_of_range if key returns k or more
+   */
+  std::vector<TDataLoop> partition_into(size_t k, const std::function<size_t(const T &)> & key);
+
+
+  /**
+   * \brief Function remove_if to remove every value that satisfies a predicate
+   *
+   * \detail One walk around the loop unlinks each matching node and frees it, returning an inline node to its slot. If the start node is removed, start moves on to the next node that remains. Handles to the other nodes stay valid.
+   *
+   * \param[in] pred A function returning true for the values to remove
+   *
+   * \return The number of values removed
+   */
+  size_t remove_if(const std::function<bool(const T &)> & pred);
+
+
+  /**
+   * \brief Function unique to remove each value equal to the value before it
+   *
+   * \detail Going forward from start in one walk, every node whose value is equal (operator==) to the last value kept is unlinked and freed, so each run of equal values is reduced to its first node. The loop is treated as beginning at start: the start node is never removed, even if the last value equals it.
+   *
+   * \return The number of values removed
+   */
+  size_t unique();
+
+
+  /**
+   * \brief Function stable_partition to move the values that satisfy a predicate in front of the others
+   *
+   * \detail The nodes are relinked, so no value is copied and handles stay valid. Values that satisfy pred come first, starting at start, followed by the rest, each group in its original order. pred is called once per value, in order, before any node moves, so if it throws the loop is unchanged. The direction flag is cleared if anything moves.
+   *
+   * \param[in] pred A function returning true for the values to move to the front
+   *
+   * \return The number of values that satisfy pred
+   */
+  size_t stable_partition(const std::function<bool(const T &)> & pred);
+
+
+  /**
+   * \brief Function compact to move every node into one contiguous block in the order of the loop
+   *
+   * \detail After many insertions and splices the nodes of a long-lived loop are scattered over the heap, and walking it costs a cache miss per node. This allocates a single block of count nodes and moves the values into it in order from start, so that walking the loop walks the block from front to back, freeing the old nodes and inline slots. Every handle, iterator and view is invalidated; windows and the index follow the moved nodes. A node in a block is freed with its loop, and the block itself is released once no loop holds any of its nodes, so a loop that gives part of a block away by splice or split shares the block with the receiving loop until both let it go.
+   */
+  void compact();
+
+
+  /**
+   * \brief Function compact_step to compact the loop a few nodes at a time
+   *
+   * \detail Moves up to budget nodes into the block of a compaction in progress, starting one if there is none, so that the work of compact can be spread over many calls, for example between requests. Nodes already moved keep their new places. If the loop is changed between two steps other than through its values, the compaction starts again from the start node with a new block. The loop is not synchronized, so steps must not run alongside other uses of the loop.
+   *
+   * \param[in] budget The greatest number of nodes to move in this step
+   *
+   * \return True once the compaction is complete
+   */
+  bool compact_step(size_t budget);
+
+
+  /**
+   * \brief Function memory_usage to report the memory the DataLoop takes
+   *
+   * \detail Walks the loop once, adding up the bytes of the nodes, the estimated allocator overhead of the heap nodes and of the compacted blocks, the heap bytes each value owns according to owned_bytes, the free inline slots and unused block space as slack, and the estimated size of the index if one is kept. A compacted block shared with other loops is split between them evenly. Nodes put aside by clear_incremental and not yet freed are counted as heap nodes. The object itself, including its inline slots in use, is counted only through node_bytes.
+   *
+   * \return The footprint of the DataLoop
+   */
+  LoopMemory memory_usage() const;
+
+
+  /**
+   * \brief Function clear_incremental to empty the DataLoop while freeing only a few nodes at a time
+   *
+   * \detail The first call empties the DataLoop at once, as clear does, but moves the heap and block nodes aside instead of freeing them, and every call then frees at most budget of the nodes put aside, so that dropping a long loop can be spread over many calls, for example between frames. Inline nodes, at most N of them, are freed by the first call, and a kept index is swapped for an empty one and dropped with the last node. The DataLoop can be used again straight away; clearing it again while nodes are still put aside adds its nodes to them. The destructor frees whatever is left.
+   *
+   * \param[in] budget The greatest number of nodes to free in this call
+   *
+   * \return True once every node put aside has been freed
+   */
+  bool clear_incremental(size_t budget);
+
+
+  /**
+   * \brief Function defer_destroy to empty the DataLoop and have its nodes freed on a background thread
+   *
+   * \detail The heap and block nodes, together with any still put aside by clear_incremental, are handed to the LoopReclaimer thread in O(1) apart from the inline nodes, so that emptying or destroying a long loop does not stall the calling thread. The values are destroyed on the reclaimer thread, so the destructor of T must be safe to run there. LoopReclaimer::drain waits until they are freed.
+   */
+  void defer_destroy();
+
+
+  /**
+   * \brief Function find_sequence to find where the values of pattern appear in order, possibly wrapping around start
+   *
+   * \detail The loop is read circularly from start, so a match may begin near the end and continue from start; no node is used twice, so a pattern longer than the DataLoop never matches. The search is KMP, O(n+m) comparisons with operator== and no copies of the values. pattern is read in its own order from its start node. An empty pattern matches nothing.
+   *
+   * \param[in] pattern The values to look for
+   *
+   * \return The offset from start of the first node of the first match, which operator^ can rotate to, or -1 if there is none
+   */
+  int find_sequence(const TDataLoop & pattern) const;
+
+
+  /**
+   * \brief Function find_all_sequences to find every place the values of pattern appear in order, possibly wrapping around start
+   *
+   * \detail As find_sequence, but every match is reported, including overlapping ones, still in O(n+m).
+   *
+   * \param[in] pattern The values to look for
+   *
+   * \return The offsets from start of the first node of each match, in increasing order
+   */
+  std::vector<int> find_all_sequences(const TDataLoop & pattern) const;
+
+
+  /**
+   * \brief Function enable_index to keep a hash index from values to nodes
+   *
+   * \detail Builds, in O(n), an unordered_multimap from each value to its nodes, which makes contains, find and rotate_to O(1) expected time. The index is kept up to date as values come and go: operator+=, including the overwrite of a bounded DataLoop, insert_before, insert_after, erase, clear and every removal update one entry each, while splice, splice_many and merge add the m nodes they take in O(m), and split removes the nodes it detaches. Reordering (sort, reverse, rotation) does not touch it. Copies of the DataLoop are indexed too, and a move takes the index along with the nodes. A value changed through a handle or iterator leaves a stale entry; call enable_index again to rebuild. Replaces any index already kept.
+   *
+   * \note Hash is only needed, along with operator==, when an index is enabled, so other value types can still be used without one.
+   *
+   * \param Hash The hash function object type, std::hash<T> by default
+   */
+  template<typename Hash = std::hash<T>>
+  void enable_index();
+
+
+  /**
+   * \brief Function disable_index to drop the hash index
+   */
+  void disable_index();
+
+
+  /**
+   * \brief Function has_index to report whether a hash index is kept
+   */
+  bool has_index() const { return bool(index); }
+
+
+  /**
+   * \brief Function contains to test whether a value is in the DataLoop
+   *
+   * \detail O(1) expected with an index, otherwise a walk from start.
+   *
+   * \param[in] value The value to look for, compared with operator==
+   */
+  bool contains(const T & value) const;
+
+
+  /**
+   * \brief Function find to get a handle to a node holding a value
+   *
+   * \detail With an index this is O(1) expected and may return any node holding value. Without one, the loop is walked from start and the first such node is returned.
+   *
+   * \param[in] value The value to look for, compared with operator==
+   *
+   * \return A handle to a node holding value, or a null handle if there is none
+   */
+  handle find(const T & value) const;
+
+
+  /**
+   * \brief Function rotate_to to make a node holding a value the start node
+   *
+   * \detail The node is found as by find, so this is O(1) expected with an index. The order of the loop does not change.
+   *
+   * \param[in] value The value to rotate to
+   *
+   * \return True if value was found and start moved to it, false if the DataLoop is unchanged
+   */
+  bool rotate_to(const T & value);
+
+
+  /**
+   * \brief Overloaded output stream operator<< to print the DataLoop
+   *
+   * \detail This operator prints the input DataLoop (dl) to the ostream (os) in the format 
+   * "-> data1 <--> data2 <--> ... <--> datax <-" where data1 is the value in the start node
+   *   e.g. if we have a DataLoop with three elements 32, 12, 20 starting at 12
+   *        it will print "-> 12 <--> 20 <--> 32 <-"
+   *   If the DataLoop is empty, it prints ">no values<".
+   *
+   * \param[in] os A reference to the output stream object
+   * \param[in] q A constant reference to the DataLoop object to be printed
+   *
+   * \return A reference to the output stream object
+   */
+  template<typename U, size_t M>
+  friend std::ostream & operator<<(std::ostream & os, const TDataLoop<U, M> & dl);
+  
+private:
+  /// friend TDataLoopTest and DataLoopTest structs to allow the test structs access to the private data
+  friend struct TDataLoopTest;
+  friend struct DataLoopTest;
+
+  /**
+   * \struct value_index
+   * \brief The hash index interface, so that hashing is only required of T when an index is enabled
+   */
+  struct value_index {
+    virtual ~value_index() { }
+
+    /// records node under its current value
+    virtual void add(_Node * node) = 0;
+
+    /// forgets node, which must still hold the value it was added with
+    virtual void remove(_Node * node) = 0;
+
+    /// a node holding value, or nullptr
+    virtual _Node * find(const T & value) const = 0;
+
+    /// forgets every node
+    virtual void clear() = 0;
+
+    /// a new empty index of the same kind
+    virtual value_index * empty_copy() const = 0;
+
+    /// the estimated heap bytes of the index, including the copies of the values it keeps
+    virtual size_t memory() const = 0;
+  };
+
+  /**
+   * \struct hash_index
+   * \brief A value_index kept in an unordered_multimap hashed with Hash
+   */
+  template<typename Hash>
+  struct hash_index : value_index {
+    std::unordered_multimap<T, _Node *, Hash> nodes;  ///< each value mapped to every node holding it
+
+    void add(_Node * node) { nodes.emplace(node->data, node); }
+
+    void remove(_Node * node) {
+      auto range = nodes.equal_range(node->data);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == node) {
+          nodes.erase(it);
+          return;
+        }
+      }
+    }
+
+    _Node * find(const T & value) const {
+      auto it = nodes.find(value);
+      return it == nodes.end() ? nullptr : it->second;
+    }
+
+    void clear() { nodes.clear(); }
+
+    value_index * empty_copy() const { return new hash_index(); }
+
+    size_t memory() const {
+      // each entry is a node holding the next pointer, the cached hash and the pair
+      size_t bytes = nodes.bucket_count() * sizeof(void *);
+      bytes += nodes.size() * heap_block_bytes(2 * sizeof(void *) + sizeof(std::pair<const T, _Node *>));
+      for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+        bytes += owned_bytes(it->first);
+      }
+      return bytes;
+    }
+  };
+
+  /// friend TDataLoopWindow so that a window can follow the nodes of the loop it watches
+  template<typename U, size_t M>
+  friend class TDataLoopWindow;
+
+  /**
+   * \struct watcher
+   * \brief The part of a TDataLoopWindow that the TDataLoop it watches calls into
+   *
+   * \detail Only operator+= reports its change. Every other change that can move values in or out of a window increments revision instead, and the window rebuilds itself the next time it is read.
+   */
+  struct watcher {
+    TDataLoop *loop;  ///< the watched loop, or nullptr once that loop is destroyed
+
+    virtual ~watcher() { }
+
+    /// called before operator+= overwrites the value at start in a full bounded loop
+    virtual void overwriting() = 0;
+
+    /// called after operator+= puts a value at the end of the loop, in node
+    virtual void appended(_Node * node) = 0;
+  };
+  
+  /**
+   * \struct _Node
+   * \brief A private structure to represent a node in a DataLoop
+   */
+  struct _Node {
+    T data;     ///< Integer node data
+    _Node *next;  ///< A pointer to the next node
+    _Node *prev;  ///< A pointer to the previous node
+  };
+
+  /**
+   * \brief Creates a node holding value, in a free inline slot if there is one, otherwise on the heap
+   *
+   * \param[in] value The value to store in the node
+   *
+   * \return The new node, with null next and prev pointers
+   */
+  _Node * make_node(const T & value);
+
+  /**
+   * \brief Destroys a node created by make_node, returning its inline slot or heap memory, or leaving its block to be released with the last loop sharing it
+   *
+   * \param[in] node The node to release
+   */
+  void free_node(_Node * node);
+
+  /// the node after node in the order of this loop
+  _Node * forward(const _Node * node) const { return reversed ? node->prev : node->next; }
+
+  /// the node before node in the order of this loop
+  _Node * backward(const _Node * node) const { return reversed ? node->next : node->prev; }
+
+  /**
+   * \brief Swaps the next and prev pointers of every node if needed so that the direction flag becomes rev, without changing the order
+   */
+  void orient(bool rev);
+
+  /**
+   * \brief Removes nodes from start, passing their values to on_evict, until count is within cap
+   */
+  void trim_to_capacity();
+
+  /**
+   * \brief Takes a node out of the loop without freeing it, moving start to the next node if needed
+   *
+   * \param[in] node A node of this DataLoop
+   */
+  void unlink(_Node * node);
+
+  /**
+   * \brief Links a node that is not in any loop into this one immediately before pos, without changing start
+   *
+   * \param[in] pos A node of this DataLoop, or nullptr if the DataLoop is empty
+   *
+   * \param[in] node The node to link in
+   */
+  void link_before(_Node * pos, _Node * node);
+
+  /**
+   * \brief Links a ring of len nodes, beginning at first, into this loop immediately before pos, without changing start
+   *
+   * \param[in] pos A node of this DataLoop, or nullptr if the DataLoop is empty
+   */
+  void link_run_before(_Node * pos, _Node * first, size_t len);
+
+  /**
+   * \brief Moves the inline nodes of rhs into free inline slots of this loop, or onto the heap, so that rhs can hand its nodes over
+   */
+  void take_inline(TDataLoop & rhs);
+
+  /**
+   * \brief Moves the run first..last of len nodes out of this loop into the empty loop part
+   *
+   * \param[in] has_start Whether the run contains the start node
+   */
+  void detach(_Node * first, _Node * last, size_t len, bool has_start, TDataLoop & part);
+
+  /**
+   * \brief Moves the value of node into a new node at slot, or on the heap if slot is nullptr, and puts the new node in its place
+   *
+   * \return The new node
+   */
+  _Node * relocate(_Node * node, void * slot);
+
+  /**
+   * \brief Moves every inline node to the heap, so that nodes can be handed to another loop
+   */
+  void spill_inline();
+
+  /**
+   * \struct _Block
+   * \brief A contiguous array of nodes allocated by compact
+   *
+   * \detail The nodes in it are constructed and destroyed one by one, and the memory is released with the last loop sharing the block.
+   */
+  struct _Block {
+    explicit _Block(size_t n) : nodes(std::allocator<_Node>().allocate(n)), size(n), live(0), freed(false) { LoopRegistry::block(n * sizeof(_Node)); }
+    ~_Block() { release(); }
+    _Block(const _Block &) = delete;
+    _Block & operator=(const _Block &) = delete;
+
+    /// releases the memory of the nodes, unless that has been done already
+    void release() {
+      if (!freed.exchange(true)) {
+        std::allocator<_Node>().deallocate(nodes, size);
+        LoopRegistry::block_freed(size * sizeof(_Node));
+      }
+    }
+
+    /// true if node lies in this block and its memory has not been released
+    bool owns(const _Node * node) const {
+      return !std::less<const _Node *>()(node, nodes) && std::less<const _Node *>()(node, nodes + size) && !freed;
+    }
+
+    _Node *nodes;  ///< the first node of the block
+    size_t size;   ///< the number of nodes the block has room for
+    std::atomic<size_t> live;  ///< the number of nodes in the block not yet freed, in any loop or by the reclaimer
+    std::atomic<bool> freed;   ///< set when the last node is freed, after which the block is an empty husk until every map holding it drops it
+  };
+
+  /// blocks keyed by the address of their first node, so the block of a node is found in O(log blocks)
+  typedef std::map<const _Node *, std::shared_ptr<_Block>, std::less<const _Node *>> block_map;
+
+  /// the block in blocks that node lies in, or nullptr if there is none
+  static _Block * find_block(const block_map & blocks, const _Node * node);
+
+  /**
+   * \brief Destroys node, which lies in block, and once none of the nodes of the block is left in any loop, releases its memory and drops it from blocks
+   *
+   * \detail Other loops sharing the block may be in use on other threads, so they are left to drop the husk themselves the next time they add to their blocks.
+   */
+  static void free_in_block(block_map & blocks, _Block * block, _Node * node);
+
+  /// adds to to the blocks of from that still hold nodes, first dropping the husks of released blocks from to
+  static void share_blocks(const block_map & from, block_map & to);
+
+  /// erases from blocks the husks of the blocks whose memory has been released
+  static void drop_husks(block_map & blocks);
+
+  /**
+   * \struct graveyard
+   * \brief The nodes of a cleared TDataLoop waiting to be freed, by clear_incremental or on the reclaimer thread
+   *
+   * \detail The nodes form a chain along next, ending in nullptr. The graveyard shares the blocks the nodes may lie in, and keeps the indexes they were listed in, so it can free them whatever becomes of the loop.
+   */
+  struct graveyard : LoopReclaimer::garbage {
+    _Node *head = nullptr;  ///< the next node to free
+    _Node *tail = nullptr;  ///< the last node of the chain
+    size_t count = 0;       ///< the number of nodes in the chain
+    block_map blocks;       ///< the blocks the nodes may lie in
+    std::vector<std::unique_ptr<value_index>> indexes;  ///< the indexes dropped with the nodes
+
+    /// frees at most budget nodes from the front of the chain, and the indexes after the last one
+    void release(size_t budget);
+
+    /// frees every node left
+    ~graveyard() { release(count); }
+  };
+
+  /**
+   * \struct extras
+   * \brief The state of the features most loops never use, allocated the first time one of them is
+   */
+  struct extras {
+    size_t cap = 0;  ///< the greatest number of values to hold, or 0 for no bound
+    std::function<void(const T &)> on_evict;  ///< called with each value evicted to stay within cap
+    std::vector<watcher *> watchers;  ///< the windows attached to this loop
+    unsigned long long revision = 0;  ///< incremented by every change, other than operator+=, that can move values in or out of a window, or nodes under a compaction in progress
+    block_map blocks;                 ///< the blocks from compact that may hold nodes of this loop
+    std::shared_ptr<_Block> pending;  ///< the block of the compaction in progress, or nullptr
+    size_t placed = 0;                ///< the number of nodes moved into pending so far
+    _Node *cursor = nullptr;          ///< the next node to move into pending
+    unsigned long long pending_revision = 0;  ///< the revision after the last step of the compaction in progress
+    std::unique_ptr<graveyard> dying;  ///< the nodes put aside by clear_incremental and not yet freed, or nullptr
+  };
+
+  /// the extras of this loop, allocating them if there are none yet
+  extras & extend();
+
+  /**
+   * \brief Increments the revision, for every change other than operator+= that can move values in or out of a window
+   *
+   * \detail A loop without extras has no window or compaction to tell, so this is a single test.
+   */
+  void touch();
+
+  /**
+   * \brief Gives up the compaction in progress, dropping its block if none of our nodes has been moved into it yet
+   */
+  void drop_pending();
+
+  /**
+   * \brief Shares the blocks of rhs, which is handing all its nodes to this loop, and drops them from rhs
+   */
+  void take_blocks(TDataLoop & rhs);
+
+  /// the block node lies in, or nullptr if it is not in one of our blocks
+  _Block * block_of(const _Node * node) const;
+
+  /// frees the inline nodes, then moves the others, the blocks they may lie in and the index to the end of the chain of g, leaving the loop empty
+  void bury(graveyard & g);
+
+  /**
+   * \brief Links the nodes into a chain along next in the order of this loop, ending in nullptr
+   *
+   * \detail The prev pointers are left as they are, so the loop is broken until from_chain is called.
+   *
+   * \return The first node of the chain, the start node
+   */
+  _Node * to_chain();
+
+  /**
+   * \brief Rebuilds the loop from a chain of all count nodes linked along next, setting the prev pointers and making head the start
+   */
+  void from_chain(_Node * head);
+
+  /**
+   * \brief Merges two chains sorted by comp into one, taking from a first on equal values
+   *
+   * \return The first node of the merged chain
+   */
+  template<typename Compare>
+  static _Node * merge_chains(_Node * a, _Node * b, Compare & comp);
+
+  /**
+   * \brief Appends to found the offset of the first match of pattern, or of every match if all is set
+   */
+  void match_sequence(const TDataLoop & pattern, bool all, std::vector<int> & found) const;
+
+  /**
+   * \brief Adds the len nodes from first, just linked into this loop, to the index if there is one
+   */
+  void index_run(_Node * first, size_t len);
+
+  /**
+   * \brief Sorts a chain with a stable bottom-up merge sort
+   *
+   * \return The first node of the sorted chain
+   */
+  template<typename Compare>
+  static _Node * sort_chain(_Node * head, Compare & comp);
+
+  /**
+   * \brief Appends each node of the null-terminated chain from head, in order, to the bucket key(node) picks, linking next and prev within each bucket
+   *
+   * \detail heads[b] and tails[b] are the ends of bucket b, or nullptr in heads[b] if it is empty. The next pointer of each tail is left as it was.
+   */
+  template<typename Key>
+  static void distribute(_Node * head, Key key, std::vector<_Node *> & heads, std::vector<_Node *> & tails);
+
+  /**
+   * \brief Calls task(i) for every i below tasks, each on its own thread when there is more than one, and waits for them all
+   */
+  static void in_parallel(size_t tasks, const std::function<void(size_t)> & task);
+
+  /**
+   * \brief Sorts arithmetic values through a temporary array of (value, node) pairs cut into runs sorted in parallel, then relinks the nodes
+   */
+  template<typename Compare>
+  void sort_runs(Compare & comp, size_t runs, std::true_type);
+
+  /**
+   * \brief Sorts other values by cutting the loop into runs of nodes that are merge sorted in parallel and then merged in pairs
+   */
+  template<typename Compare>
+  void sort_runs(Compare & comp, size_t runs, std::false_type);
+
+  _Node* start;   ///< a pointer to the starting node position in the DataLoop
+  size_t count;   ///< the count of how many nodes/values are in the structure
+  bool reversed;  ///< whether the order of the loop runs along the prev pointers
+  std::unique_ptr<value_index> index;  ///< the hash index from values to nodes, or nullptr if none is kept
+  [[no_unique_address]] TDataLoopSlots<sizeof(_Node), alignof(_Node), N> slots;  ///< inline storage for the first N nodes, taking no room when N is 0
+  std::unique_ptr<extras> ext;  ///< the state of the rarely used features, or nullptr if none has been used
+};
+
+/**
+ * \class TDataLoopWindow
+ * \brief Running sum, mean, min and max over the last values of a TDataLoop
+ *
+ * \detail A window attaches itself to a TDataLoop and covers its last width values, which end at the node before start and may wrap around start. operator+= updates every attached window in O(1) amortized time: the sum is kept running, and min and max come from monotonic deques of the values that could still become the minimum or maximum. Any other change to the loop, such as splice, erase or reverse, only marks the windows stale, and each one is recomputed in O(width) the next time it is read. A value changed through a handle or iterator is not seen until recompute is called. T needs operator+=, operator-= and operator<; sum and mean accumulate rounding error for floating point types, which recompute clears.
+ *
+ * A window must not be copied. It may outlive its loop, after which it is empty.
+ */
+template<typename T, size_t N = 0>
+class TDataLoopWindow : private TDataLoop<T, N>::watcher {
+  typedef typename TDataLoop<T, N>::_Node _Node;
+
+    public:
+  /**
+   * \brief Attaches a window over the last width values of loop
+   *
+   * \param[in] loop The TDataLoop to follow
+   *
+   * \param[in] width The greatest number of values in the window
+   *
+   * \throw std::invalid_argument if width is 0
+   */
+  TDataLoopWindow(TDataLoop<T, N> & loop, size_t width);
+
+
+  /**
+   * \brief Detaches the window from its loop
+   */
+  ~TDataLoopWindow();
+
+
+  TDataLoopWindow(const TDataLoopWindow &) = delete;
+  TDataLoopWindow & operator=(const TDataLoopWindow &) = delete;
+
+
+  /**
+   * \brief Function width to report the greatest number of values in the window
+   */
+  size_t width() const { return span; }
+
+
+  /**
+   * \brief Function size to report how many values the window covers
+   *
+   * \return The smaller of width and the length of the loop
+   */
+  size_t size() const;
+
+
+  /**
+   * \brief Function sum to add up the values in the window
+   *
+   * \return The sum, or T() if the window is empty
+   */
+  T sum() const;
+
+
+  /**
+   * \brief Function mean to average the values in the window
+   *
+   * \throw std::out_of_range if the window is empty
+   */
+  double mean() const;
+
+
+  /**
+   * \brief Function min to find the smallest value in the window
+   *
+   * \throw std::out_of_range if the window is empty
+   */
+  T min() const;
+
+
+  /**
+   * \brief Function max to find the largest value in the window
+   *
+   * \throw std::out_of_range if the window is empty
+   */
+  T max() const;
+
+
+  /**
+   * \brief Function recompute to rebuild the window from the loop in O(width)
+   *
+   * \detail This is done automatically after any change to the loop other than operator+=, but not after a value is changed through a handle or iterator.
+   */
+  void recompute() const;
+
+private:
+  void overwriting();
+  void appended(_Node * node);
+
+  /// rebuilds the window if the loop has changed or been destroyed since it was last built
+  void refresh() const;
+
+  /// adds the value of node, the newest in the loop, to the window
+  void add(_Node * node) const;
+
+  /// takes the oldest value out of the window
+  void drop() const;
+
+  size_t span;  ///< the greatest number of values in the window
+  mutable unsigned long long seen;  ///< the revision of the loop the window was built from
+  mutable _Node *oldest;  ///< the node holding the oldest value in the window
+  mutable size_t values;  ///< the number of values in the window
+  mutable T total;        ///< the running sum
+  mutable unsigned long long oldest_seq;  ///< the sequence number of the oldest value
+  mutable unsigned long long next_seq;    ///< the sequence number for the next value added
+  mutable std::deque<std::pair<unsigned long long, T>> lows;   ///< increasing candidates for min, oldest first
+  mutable std::deque<std::pair<unsigned long long, T>> highs;  ///< decreasing candidates for max, oldest first
+};
+
+#include "TDataLoop.inc"
+
+// the common instantiations are compiled once, in TDataLoop.cpp, and linked into every program that uses them
+extern template class TDataLoop<int>;
+extern template class TDataLoop<double>;
+extern template class TDataLoop<char>;
+extern template class TDataLoop<std::string>;
+
 #endif // __TDATALOOP_H__
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <atomic>
+#include <thread>
 
 using std::cout;
 using std::endl;
@@ -50,6 +52,27 @@ void segFaultHandler(int, siginfo_t*, void* context) {
   }
 #endif
 
+namespace payload {
+  /// a value that owns n heap bytes, for testing the owned_bytes customization point
+  struct Blob {
+    size_t n;
+  };
+
+  size_t owned_bytes(const Blob & b) { return b.n; }
+
+  std::atomic<int> destroyed(0);     ///< the number of Tracked values destroyed so far
+  std::thread::id destroyed_on;      ///< the thread the last Tracked value was destroyed on
+
+  /// a value that counts its destructions, for testing where and when clear_incremental and defer_destroy free nodes
+  struct Tracked {
+    int v;
+    ~Tracked() {
+      destroyed++;
+      destroyed_on = std::this_thread::get_id();
+    }
+  };
+}
+
 /**
  * \struct TDataLoopTest
  * \defgroup TDataLoopTest
@@ -703,6 +726,1198 @@ struct TDataLoopTest {
     delete w;
   }
 
+  /**
+   * \brief A test function for inline node storage, depends on operator<< and splice
+   */
+  static void InlineStorageTest() {
+    TDataLoop<int, 4> *q = new TDataLoop<int, 4>();
+    for (int i = 1; i <= 4; i++) {
+      *q += i;
+    }
+    // all four nodes live inside the object
+    ASSERT(q->count == 4);
+    ASSERT(q->slots.used == 0xF);
+    ASSERT(q->slots.owns(q->start));
+    ASSERT(q->slots.owns(q->start->prev));
+
+    // the fifth node spills to the heap
+    *q += 5;
+    ASSERT(q->count == 5);
+    ASSERT(!q->slots.owns(q->start->prev));
+    ASSERT(q->start->prev->data == 5);
+    ASSERT(q->start->prev->next == q->start);
+
+    *q ^ 4;
+    ASSERT(q->start->data == 5);
+    *q ^ -4;
+    ASSERT(q->start->data == 1);
+
+    // a copy uses its own slots
+    TDataLoop<int, 4> *r = new TDataLoop<int, 4>(*q);
+    ASSERT(*r == *q);
+    ASSERT(r->slots.owns(r->start));
+    ASSERT(!q->slots.owns(r->start));
+
+    // splicing across the inline/heap boundary
+    TDataLoop<int, 4> *p = new TDataLoop<int, 4>(20);
+    *p += 25;
+    r->splice(*p, 2);
+    ASSERT(p->count == 0);
+    ASSERT(p->slots.used == 0);
+    std::stringstream ss;
+    ss << *r;
+    ASSERT(ss.str() == "-> 1 <--> 2 <--> 20 <--> 25 <--> 3 <--> 4 <--> 5 <-");
+
+    // clearing frees the slots for reuse
+    q->clear();
+    ASSERT(q->slots.used == 0);
+    *q += 7;
+    ASSERT(q->slots.owns(q->start));
+
+    delete p;
+    delete r;
+    delete q;
+
+    // my tests
+    TDataLoop<string, 2> *m = new TDataLoop<string, 2>("a");
+    *m += "b"; *m += "c";
+    TDataLoop<string, 2> *k = new TDataLoop<string, 2>();
+    *k = *m;
+    std::stringstream ss2;
+    ss2 << *k;
+    ASSERT(ss2.str() == "-> a <--> b <--> c <-");
+    ASSERT(k->slots.used == 0x3);
+    delete m;
+    delete k;
+  }
+
+  /**
+   * \brief A test function for remove_at_offset and eliminate_every
+   */
+  static void FunctionEliminateTest() {
+    CTDataLoop *q = new CTDataLoop();
+    for (char c = 'a'; c <= 'j'; c++) {
+      *q += c;
+    }
+    ASSERT(q->remove_at_offset(3) == 'd');
+    ASSERT(q->count == 9);
+    ASSERT(q->start->data == 'e');
+    ASSERT(q->start->prev->data == 'c');
+    ASSERT(q->remove_at_offset(-1) == 'c');
+    ASSERT(q->start->data == 'e');
+
+    // every second node goes, so 'e' is the last one standing
+    CTDataLoop *r = new CTDataLoop();
+    for (char c = 'a'; c <= 'j'; c++) {
+      *r += c;
+    }
+    std::vector<char> order = r->eliminate_every(1);
+    ASSERT(string(order.begin(), order.end()) == "bdfhjcgaie");
+    ASSERT(r->count == 0);
+    ASSERT(r->start == nullptr);
+
+    delete q;
+    delete r;
+
+    // my tests
+    STDataLoop *m = new STDataLoop("only");
+    ASSERT(m->remove_at_offset(7) == "only");
+    ASSERT(m->start == nullptr);
+    bool thrown = false;
+    try {
+      m->remove_at_offset(1);
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+    delete m;
+
+    // removed inline nodes free their slots
+    TDataLoop<int, 4> *k = new TDataLoop<int, 4>();
+    for (int i = 1; i <= 6; i++) {
+      *k += i;
+    }
+    int last = 0;
+    k->eliminate_every(2, [&last](const int & value) { last = value; });
+    ASSERT(last == 1);
+    ASSERT(k->slots.used == 0);
+    delete k;
+
+    // a throwing visit leaves the loop empty and every node freed
+    using payload::Tracked;
+    TDataLoop<Tracked> t;
+    for (int i = 0; i < 6; i++) {
+      t += Tracked{i};
+    }
+    int before = payload::destroyed;
+    int visited = 0;
+    thrown = false;
+    try {
+      t.eliminate_every(0, [&visited](const Tracked &) {
+        if (++visited == 3) {
+          throw std::runtime_error("stop");
+        }
+      });
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+    ASSERT(visited == 3);
+    ASSERT(t.length() == 0);
+    ASSERT(payload::destroyed == before + 6);
+  }
+
+  /**
+   * \brief A test function for handles, iterators and O(1) insert/erase, depends on operator<<
+   */
+  static void FunctionHandleTest() {
+    STDataLoop *q = new STDataLoop();
+    *q += "a"; *q += "b"; *q += "c"; *q += "d";
+    STDataLoop::handle b = q->handle_at(1);
+    STDataLoop::handle d = q->handle_at(3);
+    ASSERT(*b == "b");
+    ASSERT(b->size() == 1);
+
+    STDataLoop::handle x = q->insert_after(b, "x");
+    q->insert_before(b, "y");
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> a <--> y <--> b <--> x <--> c <--> d <-");
+
+    ASSERT(q->erase(b) == x);
+    q->move_to_start(d);
+    std::stringstream ss2;
+    ss2 << *q;
+    ASSERT(ss2.str() == "-> d <--> a <--> y <--> x <--> c <-");
+    ASSERT(q->start->prev->data == "c");
+
+    string joined;
+    for (STDataLoop::const_iterator it = q->begin(); it != q->end(); it++) {
+      joined += *it;
+    }
+    ASSERT(joined == "dayxc");
+    STDataLoop::iterator last = q->end();
+    --last;
+    ASSERT(*last == "c");
+    ASSERT(last.to_handle() == q->prev(q->start_handle()));
+    delete q;
+
+    // my tests
+    // erasing and inserting reuses inline slots without touching other handles
+    TDataLoop<double, 3> *m = new TDataLoop<double, 3>(1.5);
+    TDataLoop<double, 3>::handle h = m->insert_after(m->start_handle(), 2.5);
+    m->insert_after(h, 3.5);
+    ASSERT(m->slots.used == 0x7);
+    m->erase(h);
+    ASSERT(m->slots.used == 0x5);
+    m->insert_before(m->start_handle(), 4.5);
+    ASSERT(m->slots.used == 0x7);
+    ASSERT(m->start->prev->data == 4.5);
+    ASSERT(m->length() == 3);
+    delete m;
+  }
+
+  /**
+   * \brief A test function for split, split_into and moving, depends on operator<<
+   */
+  static void FunctionSplitTest() {
+    STDataLoop *q = new STDataLoop();
+    *q += "a"; *q += "b"; *q += "c"; *q += "d"; *q += "e";
+    STDataLoop::handle c = q->handle_at(2);
+    STDataLoop part = q->split(c, q->handle_at(3));
+    ASSERT(part.start_handle() == c);
+    std::stringstream ss1;
+    ss1 << part << " " << *q;
+    ASSERT(ss1.str() == "-> c <--> d <- -> a <--> b <--> e <-");
+
+    std::vector<STDataLoop> parts = q->split_into(2);
+    ASSERT(parts[0].length() == 2);
+    ASSERT(parts[1].length() == 1);
+    ASSERT(parts[1].start->data == "e");
+    ASSERT(parts[1].start->next == parts[1].start);
+    delete q;
+
+    // my tests
+    // inline nodes move into the slots of the new owner, heap nodes are handed over
+    TDataLoop<int, 2> *m = new TDataLoop<int, 2>();
+    for (int i = 1; i <= 4; i++) {
+      *m += i;
+    }
+    TDataLoop<int, 2>::handle three = m->handle_at(2);
+    TDataLoop<int, 2> moved(std::move(*m));
+    ASSERT(m->count == 0);
+    ASSERT(m->slots.used == 0);
+    ASSERT(moved.slots.used == 0x3);
+    ASSERT(moved.slots.owns(moved.start));
+    ASSERT(moved.handle_at(2) == three);
+    std::stringstream ss2;
+    ss2 << moved;
+    ASSERT(ss2.str() == "-> 1 <--> 2 <--> 3 <--> 4 <-");
+
+    // splitting spills inline nodes to the heap first
+    TDataLoop<int, 2> front = moved.split(0, 3);
+    ASSERT(moved.slots.used == 0);
+    ASSERT(front.slots.used == 0);
+    ASSERT(moved.start->data == 4);
+    std::stringstream ss3;
+    ss3 << front << " " << moved;
+    ASSERT(ss3.str() == "-> 1 <--> 2 <--> 3 <- -> 4 <-");
+
+    // the handle split moves only the inline nodes it detaches
+    TDataLoop<int, 2> *k = new TDataLoop<int, 2>();
+    *k += 7; *k += 8; *k += 9;
+    TDataLoop<int, 2> tail = k->split(k->handle_at(1), k->handle_at(2));
+    ASSERT(k->slots.used == 0x1);
+    ASSERT(k->count == 1);
+    std::stringstream ss4;
+    ss4 << tail << " " << *k;
+    ASSERT(ss4.str() == "-> 8 <--> 9 <- -> 7 <-");
+    delete k;
+    delete m;
+  }
+
+  /**
+   * \brief A test function for splice_many, depends on operator<< and operator+=
+   */
+  static void FunctionSpliceManyTest() {
+    CTDataLoop *q = new CTDataLoop();
+    *q += 'a'; *q += 'b'; *q += 'c';
+    CTDataLoop x('x'), y('y'), z('z');
+    std::vector<std::pair<CTDataLoop *, size_t>> entries;
+    entries.push_back(std::make_pair(&z, 3));
+    entries.push_back(std::make_pair(&y, 1));
+    entries.push_back(std::make_pair(&x, 0));
+    q->splice_many(entries);
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> x <--> a <--> y <--> b <--> c <--> z <-");
+    ASSERT(x.count == 0 && y.count == 0 && z.count == 0);
+    delete q;
+
+    // my tests
+    // inline nodes of the sources move into free slots of the target, then onto the heap
+    TDataLoop<int, 3> *m = new TDataLoop<int, 3>(1);
+    TDataLoop<int, 3> a, b;
+    a += 10; a += 11;
+    b += 20; b += 21;
+    std::vector<std::pair<TDataLoop<int, 3> *, size_t>> more;
+    more.push_back(std::make_pair(&a, 1));
+    more.push_back(std::make_pair(&b, 1));
+    m->splice_many(more);
+    ASSERT(a.slots.used == 0);
+    ASSERT(b.slots.used == 0);
+    ASSERT(m->slots.used == 0x7);
+    std::stringstream ss2;
+    ss2 << *m;
+    ASSERT(ss2.str() == "-> 1 <--> 10 <--> 11 <--> 20 <--> 21 <-");
+    delete m;
+
+    // a loop listed twice is spliced in once, at its first position along the loop
+    CTDataLoop r('a');
+    r += 'b';
+    CTDataLoop w('w');
+    w += 'v';
+    std::vector<std::pair<CTDataLoop *, size_t>> twice;
+    twice.push_back(std::make_pair(&w, 1));
+    twice.push_back(std::make_pair(&w, 0));
+    r.splice_many(twice);
+    std::stringstream ss3;
+    ss3 << r;
+    ASSERT(ss3.str() == "-> w <--> v <--> a <--> b <-");
+    ASSERT(w.count == 0);
+  }
+
+  /**
+   * \brief A test function for reverse and materialize_reverse, depends on operator<<
+   */
+  static void FunctionReverseTest() {
+    CTDataLoop *q = new CTDataLoop();
+    *q += 'a'; *q += 'b'; *q += 'c'; *q += 'd';
+    q->reverse();
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> a <--> d <--> c <--> b <-");
+    *q += 'e';
+    ASSERT(string(q->begin(), q->end()) == "adcbe");
+
+    // a forward loop spliced into a reversed one keeps its own order
+    CTDataLoop x;
+    x += 'x'; x += 'y';
+    q->splice(x, 0);
+    ASSERT(string(q->begin(), q->end()) == "xyadcbe");
+    CTDataLoop::handle c = q->handle_at(4);
+    ASSERT(q->erase(q->handle_at(3)) == c);
+    ASSERT(string(q->begin(), q->end()) == "xyacbe");
+
+    CTDataLoop copy(*q);
+    ASSERT(!copy.is_reversed());
+    ASSERT(copy == *q);
+    q->materialize_reverse();
+    ASSERT(q->start->next->data == 'y');
+    ASSERT(copy == *q);
+    delete q;
+
+    // my tests
+    // the move constructor keeps the flag, and reversing moves no inline node
+    TDataLoop<string, 4> *m = new TDataLoop<string, 4>("1");
+    *m += "2"; *m += "3";
+    m->reverse();
+    TDataLoop<string, 4> moved(std::move(*m));
+    ASSERT(moved.is_reversed());
+    ASSERT(moved.slots.used == 0x7);
+    std::stringstream ss2;
+    ss2 << moved;
+    ASSERT(ss2.str() == "-> 1 <--> 3 <--> 2 <-");
+    delete m;
+  }
+
+  /**
+   * \brief A test function for set_capacity and capacity, depends on operator+= and operator<<
+   */
+  static void FunctionCapacityTest() {
+    std::vector<double> evicted;
+    TDataLoop<double, 3> *r = new TDataLoop<double, 3>();
+    ASSERT(r->capacity() == 0);
+    r->set_capacity(3, [&evicted](const double &v) { evicted.push_back(v); });
+    ASSERT(r->capacity() == 3);
+    *r += 1.5; *r += 2.5; *r += 3.5;
+    ASSERT(evicted.empty());
+    ASSERT(r->slots.used == 0x7);
+    TDataLoop<double, 3>::handle h = r->start_handle();
+
+    // a full loop reuses the oldest node instead of allocating
+    *r += 4.5; *r += 5.5;
+    ASSERT(evicted == std::vector<double>({1.5, 2.5}));
+    ASSERT(r->count == 3);
+    ASSERT(r->slots.used == 0x7);
+    ASSERT(*h == 4.5);
+    ASSERT(r->prev(r->start_handle()) == r->next(h));
+    std::stringstream ss1;
+    ss1 << *r;
+    ASSERT(ss1.str() == "-> 3.5 <--> 4.5 <--> 5.5 <-");
+
+    // shrinking the capacity evicts the oldest values
+    r->set_capacity(2);
+    ASSERT(r->count == 2);
+    ASSERT(r->start_handle() == h);
+    ASSERT(evicted.size() == 2);
+
+    // a copy keeps the bound
+    TDataLoop<double, 3> copy(*r);
+    ASSERT(copy.capacity() == 2);
+    copy += 6.5;
+    ASSERT(copy.length() == 2);
+    ASSERT(*copy.start_handle() == 5.5);
+    delete r;
+
+    // my tests
+    // insert and splice trim from start, and 0 removes the bound
+    TDataLoop<int> *q = new TDataLoop<int>(1);
+    *q += 2; *q += 3; *q += 4;
+    q->set_capacity(3);
+    ASSERT(q->length() == 3);
+    ASSERT(*q->start_handle() == 2);
+    q->insert_after(q->start_handle(), 9);
+    ASSERT(std::vector<int>(q->begin(), q->end()) == std::vector<int>({9, 3, 4}));
+    TDataLoop<int> s(7);
+    s += 8;
+    q->splice(s, 3);
+    ASSERT(std::vector<int>(q->begin(), q->end()) == std::vector<int>({4, 7, 8}));
+    q->set_capacity(0);
+    *q += 10;
+    ASSERT(q->length() == 4);
+    delete q;
+
+    // the bound is kept with the other rarely used state, which an unbounded loop never allocates
+    TDataLoop<int> plain(1);
+    plain.set_capacity(0);
+    TDataLoop<int> plain_copy(plain);
+    ASSERT(plain.ext == nullptr);
+    ASSERT(plain_copy.ext == nullptr);
+    TDataLoop<int> bounded(std::move(plain));
+    ASSERT(bounded.ext == nullptr);
+    bounded.set_capacity(1);
+    TDataLoop<int> moved(std::move(bounded));
+    ASSERT(moved.capacity() == 1);
+    ASSERT(bounded.capacity() == 0);
+  }
+
+  /**
+   * \brief A test function for TDataLoopWindow, depends on operator+=, set_capacity and splice
+   */
+  static void WindowTest() {
+    TDataLoop<int> *q = new TDataLoop<int>();
+    TDataLoopWindow<int> *w = new TDataLoopWindow<int>(*q, 3);
+    ASSERT(w->width() == 3);
+    ASSERT(w->size() == 0);
+    ASSERT(w->sum() == 0);
+    bool thrown = false;
+    try {
+      w->min();
+    }
+    catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+
+    *q += 5; *q += 1; *q += 4;
+    ASSERT(w->size() == 3);
+    ASSERT(w->sum() == 10);
+    ASSERT(w->min() == 1);
+    ASSERT(w->max() == 5);
+    *q += 2;
+    ASSERT(w->sum() == 7);
+    ASSERT(w->min() == 1);
+    ASSERT(w->max() == 4);
+    *q += 3; *q += 3;
+    ASSERT(w->sum() == 8);
+    ASSERT(w->min() == 2);
+    ASSERT(w->max() == 3);
+
+    // a window that wraps around start after the loop is rotated
+    *q ^ 2; // 4 2 3 3 5 1
+    ASSERT(w->sum() == 9);
+    ASSERT(w->min() == 1);
+    ASSERT(w->max() == 5);
+
+    // splice marks the window stale and it is rebuilt on the next read
+    TDataLoop<int> tail(9);
+    q->splice(tail, 6);
+    ASSERT(w->sum() == 15);
+    ASSERT(w->max() == 9);
+    ASSERT(w->mean() == 5.0);
+    delete w;
+    delete q;
+
+    // my tests
+    // a bounded telemetry ring that overwrites in place, with a window covering all of it
+    TDataLoop<double, 4> r;
+    r.set_capacity(4);
+    TDataLoopWindow<double, 4> all(r, 4);
+    TDataLoopWindow<double, 4> last(r, 2);
+    double samples[] = {1.0, 8.0, 2.0, 7.0, 3.0, 0.5, 6.0};
+    for (size_t i = 0; i < 7; i++) {
+      r += samples[i];
+    }
+    ASSERT(r.slots.used == 0xF);
+    ASSERT(all.size() == 4);
+    ASSERT(all.sum() == 16.5);
+    ASSERT(all.min() == 0.5);
+    ASSERT(all.max() == 7.0);
+    ASSERT(last.mean() == 3.25);
+    r.reverse(); // 7 6 0.5 3
+    ASSERT(last.sum() == 3.5);
+    ASSERT(all.max() == 7.0);
+
+    // a window outliving its loop is empty
+    TDataLoop<int> *p = new TDataLoop<int>(1);
+    TDataLoopWindow<int> orphan(*p, 2);
+    ASSERT(orphan.sum() == 1);
+    delete p;
+    ASSERT(orphan.size() == 0);
+
+    // a width of 0 is rejected
+    thrown = false;
+    try {
+      TDataLoopWindow<int> none(tail, 0);
+    }
+    catch (const std::invalid_argument &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+
+    // a loop keeps no revision until a window attaches, and the window still sees later changes
+    TDataLoop<int> unwatched(1);
+    unwatched += 2;
+    unwatched.reverse();
+    unwatched.erase(unwatched.start_handle());
+    ASSERT(unwatched.ext == nullptr);
+    TDataLoopWindow<int> late(unwatched, 2);
+    ASSERT(unwatched.ext != nullptr);
+    ASSERT(late.sum() == 2);
+    unwatched += 5;
+    unwatched.erase(unwatched.start_handle());
+    ASSERT(late.sum() == 5);
+    ASSERT(late.min() == 5);
+  }
+
+  /**
+   * \brief A test function for sort, parallel_sort and merge, depends on operator+= and operator<<
+   */
+  static void FunctionSortTest() {
+    CTDataLoop *q = new CTDataLoop('d');
+    *q += 'b'; *q += 'e'; *q += 'a'; *q += 'c';
+    CTDataLoop::handle h = q->handle_at(2);
+    q->sort();
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> a <--> b <--> c <--> d <--> e <-");
+    ASSERT(*h == 'e');
+    ASSERT(q->next(h) == q->start_handle());
+    q->sort(std::greater<char>());
+    ASSERT(string(q->begin(), q->end()) == "edcba");
+    ASSERT(q->start_handle() == h);
+
+    // merge interleaves the nodes of two sorted loops and empties the other one
+    q->reverse();
+    *q ^ 1;
+    CTDataLoop x('b');
+    x += 'c'; x += 'f';
+    q->merge(x);
+    ASSERT(string(q->begin(), q->end()) == "abbccdef");
+    ASSERT(!q->is_reversed());
+    ASSERT(x.length() == 0);
+    ASSERT(q->start->prev->data == 'f');
+    delete q;
+
+    // the sort is stable, comparing only the first letter
+    STDataLoop s("b1");
+    s += "a1"; s += "b2"; s += "a2"; s += "c1"; s += "a3";
+    s.reverse(); // b1 a3 c1 a2 b2 a1
+    s.sort([](const string & l, const string & r) { return l[0] < r[0]; });
+    std::stringstream ss2;
+    ss2 << s;
+    ASSERT(ss2.str() == "-> a3 <--> a2 <--> a1 <--> b1 <--> b2 <--> c1 <-");
+
+    // my tests
+    // parallel_sort agrees with std::stable_sort on a loop long enough to use threads
+    typedef std::vector<std::pair<int, int>> Pairs;
+    Pairs expected;
+    TDataLoop<std::pair<int, int>> p;
+    unsigned seed = 12345;
+    for (int i = 0; i < 100000; i++) {
+      seed = seed * 1103515245 + 12345;
+      std::pair<int, int> v((seed >> 16) % 1000, i);
+      expected.push_back(v);
+      p += v;
+    }
+    auto by_first = [](const std::pair<int, int> & l, const std::pair<int, int> & r) { return l.first < r.first; };
+    std::stable_sort(expected.begin(), expected.end(), by_first);
+    p.parallel_sort(by_first, 5);
+    ASSERT(Pairs(p.begin(), p.end()) == expected);
+    ASSERT(p.length() == 100000);
+
+    // merge keeps inline nodes in their object and respects a capacity
+    TDataLoop<int, 2> a(1);
+    a += 4;
+    TDataLoop<int, 2> b(2);
+    b += 3; b += 5;
+    a.set_capacity(4);
+    a.merge(b);
+    ASSERT(std::vector<int>(a.begin(), a.end()) == std::vector<int>({2, 3, 4, 5}));
+    ASSERT(b.slots.used == 0);
+    ASSERT(a.slots.used == 0x2); // 1 was evicted from the first slot
+  }
+
+  /**
+   * \brief A test function for radix_sort and partition_into, depends on operator+= and operator<<
+   */
+  static void FunctionRadixTest() {
+    CTDataLoop *q = new CTDataLoop('q');
+    *q += 'Z'; *q += '!'; *q += 'a'; *q += static_cast<char>(-3);
+    CTDataLoop::handle h = q->handle_at(1);
+    q->radix_sort();
+    std::vector<char> chars(q->begin(), q->end());
+    ASSERT(std::is_sorted(chars.begin(), chars.end()));
+    ASSERT(*h == 'Z');
+    ASSERT(q->start->prev->next == q->start);
+    delete q;
+
+    TDataLoop<int> *r = new TDataLoop<int>(300);
+    *r += -70000; *r += 5; *r += -1; *r += 65536; *r += 5; *r += 0;
+    r->reverse(); // 300 0 5 65536 -1 5 -70000
+    TDataLoop<int>::handle five = r->handle_at(2);
+    r->radix_sort();
+    std::stringstream ss1;
+    ss1 << *r;
+    ASSERT(ss1.str() == "-> -70000 <--> -1 <--> 0 <--> 5 <--> 5 <--> 300 <--> 65536 <-");
+    ASSERT(r->handle_at(3) == five); // stable: the first 5 stays first
+    ASSERT(!r->is_reversed());
+    ASSERT(*r->prev(r->start_handle()) == 65536);
+
+    // partition_into keeps the order within each part and empties the loop
+    std::vector<TDataLoop<int>> parts = r->partition_into(3, [](const int & v) { return static_cast<size_t>(v < 0 ? 0 : (v < 100 ? 1 : 2)); });
+    ASSERT(parts.size() == 3);
+    ASSERT(r->length() == 0);
+    std::stringstream ss2;
+    ss2 << parts[0] << parts[1] << parts[2];
+    ASSERT(ss2.str() == "-> -70000 <--> -1 <-" "-> 0 <--> 5 <--> 5 <-" "-> 300 <--> 65536 <-");
+    ASSERT(parts[1].handle_at(1) == five);
+    delete r;
+
+    // my tests
+    // unsigned 64 bit values with only a high byte differing, and equal values
+    TDataLoop<unsigned long long> u(3ULL << 56);
+    u += 1ULL << 56; u += 2ULL << 56; u += 1ULL << 56;
+    u.radix_sort();
+    ASSERT(std::vector<unsigned long long>(u.begin(), u.end()) ==
+           std::vector<unsigned long long>({1ULL << 56, 1ULL << 56, 2ULL << 56, 3ULL << 56}));
+    TDataLoop<short> same(4);
+    same += 4; same += 4;
+    same.radix_sort();
+    ASSERT(same.length() == 3 && same.start->prev->next == same.start && same.start->next->next->next == same.start);
+
+    // a key that is too large leaves the loop alone, and inline nodes are spilled
+    TDataLoop<string, 2> s("ab");
+    s += "c"; s += "de";
+    bool thrown = false;
+    try {
+      s.partition_into(2, [](const string & v) { return v.size(); });
+    }
+    catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+    ASSERT(s.length() == 3);
+    std::vector<TDataLoop<string, 2>> by_size = s.partition_into(3, [](const string & v) { return v.size(); });
+    ASSERT(s.slots.used == 0);
+    ASSERT(by_size[0].length() == 0);
+    ASSERT(by_size[2].length() == 2);
+    ASSERT(*by_size[2].start_handle() == "ab");
+    ASSERT(*by_size[1].start_handle() == "c");
+  }
+
+  /**
+   * \brief A test function for remove_if, unique and stable_partition, depends on operator+= and operator<<
+   */
+  static void FunctionFilterTest() {
+    STDataLoop *q = new STDataLoop("x1");
+    *q += "a"; *q += "x2"; *q += "b"; *q += "x3";
+    STDataLoop::handle b = q->handle_at(3);
+    ASSERT(q->remove_if([](const string & v) { return v[0] == 'x'; }) == 3);
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> a <--> b <-");  // start moved past the removed start node
+    ASSERT(q->next(q->start_handle()) == b);
+    ASSERT(q->remove_if([](const string &) { return true; }) == 2);
+    ASSERT(q->length() == 0 && q->start == nullptr);
+    ASSERT(q->remove_if([](const string &) { return true; }) == 0);
+    delete q;
+
+    CTDataLoop c('a');
+    c += 'a'; c += 'b'; c += 'b'; c += 'b'; c += 'c'; c += 'a'; c += 'a';
+    ASSERT(c.unique() == 4);
+    ASSERT(string(c.begin(), c.end()) == "abca");  // the last a is not compared with start
+    ASSERT(c.unique() == 0);
+
+    // stable_partition relinks the matching values to the front, keeping handles
+    TDataLoop<int> *p = new TDataLoop<int>(1);
+    *p += 2; *p += 3; *p += 4; *p += 5; *p += 6;
+    p->reverse(); // 1 6 5 4 3 2
+    TDataLoop<int>::handle four = p->handle_at(3);
+    ASSERT(p->stable_partition([](const int & v) { return v % 2 == 0; }) == 3);
+    ASSERT(std::vector<int>(p->begin(), p->end()) == std::vector<int>({6, 4, 2, 1, 5, 3}));
+    ASSERT(p->handle_at(1) == four);
+    ASSERT(!p->is_reversed());
+    ASSERT(*p->prev(p->start_handle()) == 3);
+    delete p;
+
+    // my tests
+    // removal returns inline nodes to their slots, and a throwing predicate leaves the loop unchanged
+    TDataLoop<int, 4> s(1);
+    s += 2; s += 3; s += 4; s += 5;
+    ASSERT(s.remove_if([](const int & v) { return v < 3; }) == 2);
+    ASSERT(s.slots.used == 0xC);
+    s += 6;
+    ASSERT(s.slots.used == 0xD);
+    bool thrown = false;
+    try {
+      s.stable_partition([](const int & v) -> bool { if (v == 5) throw std::runtime_error("bad"); return v > 3; });
+    }
+    catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    ASSERT(thrown);
+    ASSERT(std::vector<int>(s.begin(), s.end()) == std::vector<int>({3, 4, 5, 6}));
+    ASSERT(s.stable_partition([](const int & v) { return v > 10; }) == 0);
+    ASSERT(s.stable_partition([](const int & v) { return v > 3; }) == 3);
+    ASSERT(std::vector<int>(s.begin(), s.end()) == std::vector<int>({4, 5, 6, 3}));
+  }
+
+  /**
+   * \brief A test function for the hash index with contains, find and rotate_to, depends on operator+= and operator<<
+   */
+  static void FunctionIndexTest() {
+    STDataLoop *q = new STDataLoop("red");
+    *q += "green"; *q += "blue";
+    ASSERT(!q->has_index());
+    ASSERT(q->contains("blue"));           // a walk without an index
+    ASSERT(*q->find("green") == "green");
+    q->enable_index();
+    ASSERT(q->has_index());
+    ASSERT(q->contains("red") && !q->contains("cyan"));
+    ASSERT(!q->find("cyan"));
+    *q += "cyan";
+    ASSERT(q->find("cyan") == q->handle_at(3));
+    ASSERT(q->rotate_to("blue"));
+    std::stringstream ss1;
+    ss1 << *q;
+    ASSERT(ss1.str() == "-> blue <--> cyan <--> red <--> green <-");
+    ASSERT(!q->rotate_to("pink"));
+    q->erase(q->find("red"));
+    ASSERT(!q->contains("red"));
+    ASSERT(q->remove_if([](const string & v) { return v == "cyan"; }) == 1);
+    ASSERT(!q->contains("cyan"));
+
+    // splice brings the nodes of rhs into the index, and split takes them out
+    STDataLoop other("pink");
+    other += "gray";
+    other.enable_index();
+    q->splice(other, 1);
+    ASSERT(q->contains("pink") && q->contains("gray"));
+    ASSERT(!other.contains("pink"));
+    STDataLoop part = q->split(1, 2);
+    ASSERT(!q->contains("pink") && !q->contains("gray"));
+    ASSERT(q->contains("green"));
+    ASSERT(!part.has_index());
+
+    // copies are indexed, and clear empties the index
+    STDataLoop copy(*q);
+    ASSERT(copy.has_index() && copy.contains("blue"));
+    ASSERT(copy.find("blue") != q->find("blue"));
+    q->clear();
+    ASSERT(!q->contains("blue"));
+    *q += "blue";
+    ASSERT(q->find("blue") == q->start_handle());
+    q->disable_index();
+    ASSERT(!q->has_index() && q->contains("blue"));
+    delete q;
+
+    // my tests
+    // an overwriting bounded loop replaces the entry of the value it evicts, and inline nodes are tracked when moved
+    TDataLoop<int, 2> r(1);
+    r += 2;
+    r.enable_index();
+    r.set_capacity(2);
+    r += 3;
+    ASSERT(!r.contains(1) && r.contains(2) && r.contains(3));
+    ASSERT(r.slots.used == 0x3);
+    TDataLoop<int, 2> moved(std::move(r));
+    ASSERT(moved.has_index() && !r.has_index());
+    ASSERT(moved.find(3) == moved.prev(moved.start_handle()));
+    moved.sort(std::greater<int>());
+    ASSERT(moved.rotate_to(2));
+    ASSERT(*moved.start_handle() == 2);
+
+    // a custom hash, and a merge that adds the other loop's nodes
+    struct Mod10 {
+      size_t operator()(int v) const { return static_cast<size_t>(v % 10); }
+    };
+    TDataLoop<int> a(10);
+    a += 30;
+    a.enable_index<Mod10>();
+    TDataLoop<int> b(20);
+    b += 40;
+    a.merge(b);
+    ASSERT(a.contains(20) && a.contains(40) && !a.contains(50));
+    ASSERT(a.rotate_to(40));
+    ASSERT(std::vector<int>(a.begin(), a.end()) == std::vector<int>({40, 10, 20, 30}));
+  }
+
+  /**
+   * \brief A test function for find_sequence and find_all_sequences, depends on operator+= and operator^
+   */
+  static void FunctionFindSequenceTest() {
+    CTDataLoop *q = new CTDataLoop('c');
+    *q += 'a'; *q += 'b'; *q += 'c'; *q += 'a'; *q += 'b';
+    CTDataLoop p('a');
+    p += 'b';
+    p += 'c';
+    ASSERT(q->find_sequence(p) == 1);
+    ASSERT(q->find_all_sequences(p) == std::vector<int>({1, 4})); // the second match wraps to start
+    *q ^ 4;
+    ASSERT(string(q->begin(), q->end()) == "abcabc");
+
+    // an overlapping pattern, and one longer than the loop
+    CTDataLoop bb('b');
+    bb += 'c'; bb += 'a'; bb += 'b'; bb += 'c';
+    ASSERT(q->find_all_sequences(bb) == std::vector<int>({1, 4}));
+    bb += 'a'; bb += 'b';
+    ASSERT(q->find_sequence(bb) == -1);
+    ASSERT(q->find_all_sequences(CTDataLoop()).empty());
+    delete q;
+
+    // my tests
+    // reversed loops on either side are read in their own order
+    STDataLoop s("x");
+    s += "y"; s += "z"; s += "w";
+    s.reverse(); // x w z y
+    STDataLoop pat("y");
+    pat += "x";
+    ASSERT(s.find_sequence(pat) == 3);
+    pat.reverse();
+    pat += "w";    // y x w, read along the reversed links of pat
+    ASSERT(s.find_all_sequences(pat) == std::vector<int>({3}));
+    pat.reverse(); // y w x
+    ASSERT(s.find_sequence(pat) == -1);
+    pat.reverse();
+    s ^ s.find_sequence(pat);
+    ASSERT(*s.start_handle() == "y");
+
+    // a loop of one repeated value matches at every offset
+    TDataLoop<int> ones(1);
+    ones += 1; ones += 1;
+    TDataLoop<int> two(1);
+    two += 1;
+    ASSERT(ones.find_all_sequences(two) == std::vector<int>({0, 1, 2}));
+    ASSERT(ones.find_all_sequences(ones) == std::vector<int>({0, 1, 2}));
+  }
+
+  /**
+   * \brief A test function for LoopView, depends on operator+=, operator^ and operator<<
+   */
+  static void LoopViewTest() {
+    CTDataLoop *q = new CTDataLoop('a');
+    *q += 'b'; *q += 'c'; *q += 'd';
+    CTDataLoop::LoopView v1 = q->view();
+    CTDataLoop::LoopView v2 = q->view(2);
+    ASSERT(v1 == *q && *q == v1);
+    ASSERT(v2 != *q);
+    ASSERT(string(v2.begin(), v2.end()) == "cdab");
+    v1 ^ -1;
+    std::stringstream ss1;
+    ss1 << v1 << " " << v2 << " " << *q;
+    ASSERT(ss1.str() == "-> d <--> a <--> b <--> c <- -> c <--> d <--> a <--> b <- -> a <--> b <--> c <--> d <-");
+    ASSERT(*v1.start_handle() == 'd');
+    ASSERT(q->start->data == 'a');  // the loop itself is not rotated
+
+    // views see changes to the loop, and compare with rotated loops and each other
+    *q += 'e';
+    ASSERT(string(v2.begin(), v2.end()) == "cdeab");
+    ASSERT(v2.length() == 5);
+    CTDataLoop copy(*q);
+    copy ^ 2;
+    ASSERT(v2 == copy);
+    v1 ^ 4;
+    ASSERT(v1 == v2);
+    q->reverse();
+    ASSERT(string(v2.begin(), v2.end()) == "cbaed");
+    delete q;
+
+    // my tests
+    // a view of an empty loop follows its start, and large offsets wrap
+    STDataLoop e;
+    STDataLoop::LoopView ev = e.view(5);
+    std::stringstream ss2;
+    ss2 << ev;
+    ASSERT(ss2.str() == ">no values<");
+    ASSERT(ev == e);
+    e += "x"; e += "y"; e += "z";
+    ASSERT(*ev.start_handle() == "x");
+    ev ^ 7;
+    ASSERT(*ev.start_handle() == "y");
+    ev ^ -7;
+    ASSERT(*ev.start_handle() == "x");
+    ASSERT(*e.view(-1).start_handle() == "z");
+  }
+
+  /**
+   * \brief A test function for compact and compact_step
+   */
+  static void FunctionCompactTest() {
+    STDataLoop *q = new STDataLoop();
+    for (int i = 0; i < 8; i++) {
+      *q += string(1, static_cast<char>('a' + i));
+    }
+    *q ^ 2;
+    q->reverse();
+    q->enable_index();
+    std::stringstream before;
+    before << *q;
+    q->compact();
+    std::stringstream after;
+    after << *q;
+    ASSERT(after.str() == before.str());
+    ASSERT(after.str() == "-> c <--> b <--> a <--> h <--> g <--> f <--> e <--> d <-");
+    ASSERT(q->is_reversed());
+
+    // walking the loop walks the block from front to back
+    ASSERT(q->ext->blocks.size() == 1);
+    ASSERT(q->start == q->ext->blocks.begin()->second->nodes);
+    bool in_order = true;
+    STDataLoop::_Node *cur = q->start;
+    for (int i = 0; i < 8; i++) {
+      in_order = in_order && cur == q->start + i;
+      cur = q->forward(cur);
+    }
+    ASSERT(in_order);
+
+    // the index follows the moved nodes
+    ASSERT(q->find("g") == q->handle_at(4));
+    q->erase(q->find("g"));
+    ASSERT(!q->contains("g"));
+    *q += "z";
+    ASSERT(q->find("z") == q->handle_at(7));
+
+    // a split shares the block, which outlives the loop it came from
+    STDataLoop part = q->split(1, 3);
+    ASSERT(part.ext->blocks.size() == 1);
+    delete q;
+    std::stringstream ss1;
+    ss1 << part;
+    ASSERT(ss1.str() == "-> b <--> a <--> h <-");
+
+    // compaction a few nodes at a time, with inline slots and a window
+    TDataLoop<int, 2> r;
+    TDataLoopWindow<int, 2> w(r, 3);
+    for (int i = 1; i <= 7; i++) {
+      r += i;
+    }
+    r ^ 3;
+    ASSERT(!r.compact_step(3));
+    ASSERT(r.ext->placed == 3);
+    ASSERT(r.start == r.ext->pending->nodes);
+    ASSERT(!r.compact_step(3));
+    ASSERT(r.compact_step(3));
+    ASSERT(r.ext->pending == nullptr);
+    ASSERT(r.start == r.ext->blocks.begin()->second->nodes);
+    ASSERT(r.slots.used == 0);
+    std::stringstream ss2;
+    ss2 << r;
+    ASSERT(ss2.str() == "-> 4 <--> 5 <--> 6 <--> 7 <--> 1 <--> 2 <--> 3 <-");
+    ASSERT(w.sum() == 6);
+
+    // a change between steps starts the compaction again
+    ASSERT(!r.compact_step(2));
+    r += 8;
+    ASSERT(!r.compact_step(2));
+    ASSERT(r.ext->placed == 2);
+    ASSERT(r.ext->pending->size == 8);
+    r.remove_at_offset(0);
+    ASSERT(r.compact_step(100));
+    ASSERT(r.ext->blocks.size() == 1);
+    std::stringstream ss3;
+    ss3 << r;
+    ASSERT(ss3.str() == "-> 5 <--> 6 <--> 7 <--> 1 <--> 2 <--> 3 <--> 8 <-");
+    ASSERT(w.sum() == 13);
+
+    // my tests
+    STDataLoop empty;
+    ASSERT(empty.compact_step(1));
+    empty.compact();
+    ASSERT((!empty.ext || empty.ext->blocks.empty()));
+
+    // a splice hands the block over with the nodes
+    STDataLoop s("x");
+    s.splice(part, 1);
+    ASSERT((!part.ext || part.ext->blocks.empty()));
+    ASSERT(s.ext->blocks.size() == 1);
+    STDataLoop moved = std::move(s);
+    ASSERT(moved.ext->blocks.size() == 1);
+    std::stringstream ss4;
+    ss4 << moved;
+    ASSERT(ss4.str() == "-> x <--> b <--> a <--> h <-");
+
+    // a block is forgotten once its last node is freed
+    moved.erase(moved.handle_at(1));
+    moved.erase(moved.handle_at(1));
+    ASSERT(moved.ext->blocks.size() == 1);
+    moved.erase(moved.handle_at(1));
+    ASSERT((!moved.ext || moved.ext->blocks.empty()));
+    ASSERT(moved.length() == 1);
+
+    // each node finds its block among many, taken in by splice
+    TDataLoop<int> many;
+    for (int i = 0; i < 200; i++) {
+      TDataLoop<int> piece;
+      piece += 2 * i;
+      piece += 2 * i + 1;
+      piece.compact();
+      many.splice(piece, many.length());
+    }
+    ASSERT(many.ext->blocks.size() == 200);
+    ASSERT(many.memory_usage().overhead_bytes == 200 * (heap_block_bytes(2 * sizeof(TDataLoop<int>::_Node)) - 2 * sizeof(TDataLoop<int>::_Node)));
+    in_order = true;
+    for (int i = 0; i < 200; i++) {
+      in_order = in_order && many.remove_at_offset(0) == i;
+    }
+    ASSERT(in_order);
+    ASSERT(many.ext->blocks.size() == 100);
+    ASSERT(*many.handle_at(0) == 200);
+  }
+
+  /**
+   * \brief A test function for memory_usage and the registry
+   */
+  static void FunctionMemoryUsageTest() {
+    // short strings stay in the string object, long ones own a buffer
+    STDataLoop *q = new STDataLoop("short");
+    size_t node = sizeof(STDataLoop::_Node);
+    LoopMemory m1 = q->memory_usage();
+    ASSERT(m1.node_bytes == node);
+    ASSERT(m1.value_bytes == 0);
+    ASSERT(m1.overhead_bytes == heap_block_bytes(node) - node);
+    *q += string(100, 'x');
+    LoopMemory m2 = q->memory_usage();
+    ASSERT(m2.value_bytes == q->handle_at(1)->capacity() + 1);
+    ASSERT(m2.node_bytes == 2 * node);
+
+    // the index and its copies of the values count as overhead
+    q->enable_index();
+    LoopMemory m3 = q->memory_usage();
+    ASSERT(m3.overhead_bytes > m2.overhead_bytes + q->handle_at(1)->capacity());
+    ASSERT(m3.value_bytes == m2.value_bytes);
+    delete q;
+
+    // containers report what they own
+    TDataLoop<std::vector<int>> v;
+    std::vector<int> values(10);
+    v += values;
+    v += std::vector<int>();
+    ASSERT(v.memory_usage().value_bytes == v.handle_at(0)->capacity() * sizeof(int));
+    TDataLoop<std::pair<string, int>> p;
+    p += std::make_pair(string(50, 'y'), 1);
+    ASSERT(p.memory_usage().value_bytes == p.handle_at(0)->first.capacity() + 1);
+
+    // a type can report what it owns through its own owned_bytes
+    TDataLoop<payload::Blob> b;
+    b += payload::Blob{40};
+    b += payload::Blob{2};
+    ASSERT(b.memory_usage().value_bytes == 42);
+
+    // inline slots cost no allocation, and free ones are slack
+    TDataLoop<int, 4> r;
+    size_t inode = sizeof(TDataLoop<int, 4>::_Node);
+    r += 1;
+    r += 2;
+    LoopMemory m4 = r.memory_usage();
+    ASSERT(m4.node_bytes == 2 * inode);
+    ASSERT(m4.overhead_bytes == 0);
+    ASSERT(m4.slack_bytes == 2 * inode);
+    for (int i = 3; i <= 8; i++) {
+      r += i;
+    }
+    LoopMemory m5 = r.memory_usage();
+    ASSERT(m5.node_bytes == 8 * inode);
+    ASSERT(m5.slack_bytes == 0);
+    ASSERT(m5.overhead_bytes == 4 * (heap_block_bytes(inode) - inode));
+
+    // after compaction the nodes are in one block, and the inline slots are all free
+    r.compact();
+    LoopMemory m6 = r.memory_usage();
+    ASSERT(m6.overhead_bytes == heap_block_bytes(8 * inode) - 8 * inode);
+    ASSERT(m6.slack_bytes == 4 * inode);
+
+    // the registry counts the heap nodes of loops of every type
+    LoopMemory before = LoopRegistry::total();
+    {
+      DTDataLoop d(1.5);
+      CTDataLoop c('c');
+      ASSERT(LoopRegistry::total().total() == before.total() + d.memory_usage().total() + c.memory_usage().total());
+    }
+    ASSERT(LoopRegistry::total().total() == before.total());
+
+    // and of every thread, even while the loops change, keeping the counts of a thread after it exits
+    CTDataLoop *made = nullptr;
+    std::thread maker([&made]() {
+      made = new CTDataLoop();
+      for (int i = 0; i < 10; i++) {
+        *made += 'x';
+      }
+    });
+    maker.join();
+    ASSERT(LoopRegistry::total().node_bytes == before.node_bytes + 10 * sizeof(CTDataLoop::_Node));
+    std::atomic<bool> reading(true);
+    std::thread reader([&reading]() {
+      while (reading) {
+        LoopRegistry::total();
+      }
+    });
+    for (int i = 0; i < 1000; i++) {
+      *made += 'y';
+    }
+    reading = false;
+    reader.join();
+    ASSERT(LoopRegistry::total().node_bytes == before.node_bytes + 1010 * sizeof(CTDataLoop::_Node));
+    delete made;
+    ASSERT(LoopRegistry::total().total() == before.total());
+
+    // my tests
+    CTDataLoop empty;
+    ASSERT(empty.memory_usage().total() == 0);
+    TDataLoop<int, 4> copy(r);
+    ASSERT(copy.memory_usage().slack_bytes == 0);
+    ASSERT(copy.memory_usage().overhead_bytes == 4 * (heap_block_bytes(inode) - inode));
+  }
+
+  /**
+   * \brief A test function for clear_incremental and defer_destroy
+   */
+  static void FunctionClearIncrementalTest() {
+    using payload::Tracked;
+    TDataLoop<Tracked> q;
+    for (int i = 0; i < 10; i++) {
+      q += Tracked{i};
+    }
+
+    // the loop is empty after the first call, and the values are destroyed a few at a time
+    int before = payload::destroyed;
+    ASSERT(!q.clear_incremental(3));
+    ASSERT(q.length() == 0);
+    ASSERT(payload::destroyed == before + 3);
+    ASSERT(q.memory_usage().node_bytes == 7 * sizeof(TDataLoop<Tracked>::_Node));
+    q += Tracked{20};
+    ASSERT(q.handle_at(0)->v == 20);
+    before = payload::destroyed;
+    ASSERT(!q.clear_incremental(5));
+    ASSERT(payload::destroyed == before + 5);
+    ASSERT(q.clear_incremental(5));
+    ASSERT(payload::destroyed == before + 8);
+    ASSERT((!q.ext || q.ext->dying == nullptr));
+
+    // inline nodes are freed at once, the others wait, and the index is swapped for an empty one
+    TDataLoop<string, 4> s;
+    for (int i = 0; i < 8; i++) {
+      s += std::to_string(i);
+    }
+    s.enable_index();
+    ASSERT(!s.clear_incremental(1));
+    ASSERT(s.slots.in_use() == 0);
+    ASSERT(s.ext->dying->count == 3);
+    ASSERT(s.ext->dying->indexes.size() == 1);
+    ASSERT(s.has_index());
+    s += "8";
+    ASSERT(s.contains("8"));
+    ASSERT(!s.contains("7"));
+    ASSERT(s.slots.in_use() == 1);
+    ASSERT(s.clear_incremental(3));
+    ASSERT(s.length() == 0);
+
+    // a deferred loop is destroyed on the reclaimer thread, with its compacted block
+    TDataLoop<Tracked> *r = new TDataLoop<Tracked>();
+    for (int i = 0; i < 1000; i++) {
+      *r += Tracked{i};
+    }
+    r->compact();
+    std::weak_ptr<TDataLoop<Tracked>::_Block> block = r->ext->blocks.begin()->second;
+    *r += Tracked{1000};
+    LoopReclaimer::drain();
+    before = payload::destroyed;
+    r->defer_destroy();
+    ASSERT(r->length() == 0);
+    delete r;
+    LoopReclaimer::drain();
+    ASSERT(payload::destroyed == before + 1001);
+    ASSERT(payload::destroyed_on != std::this_thread::get_id());
+    ASSERT(block.expired());
+
+    // my tests
+    STDataLoop empty;
+    ASSERT(empty.clear_incremental(0));
+    empty.defer_destroy();
+    ASSERT(LoopReclaimer::pending() == 0);
+
+    // a loop dropped partway frees the rest in its destructor
+    {
+      TDataLoop<Tracked> t;
+      t += Tracked{1};
+      t += Tracked{2};
+      before = payload::destroyed;
+      t.clear_incremental(1);
+    }
+    ASSERT(payload::destroyed == before + 2);
+  }
+
 };
 
 // call our test functions in the main
@@ -732,6 +1947,23 @@ int main(int, char* argv[]) {
   TDataLoopTest::OperatorShiftTest();  // char
   TDataLoopTest::FunctionLengthTest();  // string
   TDataLoopTest::FunctionSpliceTest();   // int
+  TDataLoopTest::InlineStorageTest();   // int, string
+  TDataLoopTest::FunctionEliminateTest();   // char, string, int
+  TDataLoopTest::FunctionHandleTest();   // string, double
+  TDataLoopTest::FunctionSplitTest();   // string, int
+  TDataLoopTest::FunctionSpliceManyTest();   // char, int
+  TDataLoopTest::FunctionReverseTest();   // char, string
+  TDataLoopTest::FunctionCapacityTest();   // double, int
+  TDataLoopTest::WindowTest();   // int, double
+  TDataLoopTest::FunctionSortTest();   // char, string, pair, int
+  TDataLoopTest::FunctionRadixTest();   // char, int, unsigned long long, short, string
+  TDataLoopTest::FunctionFilterTest();   // string, char, int
+  TDataLoopTest::FunctionIndexTest();   // string, int
+  TDataLoopTest::FunctionFindSequenceTest();   // char, string, int
+  TDataLoopTest::LoopViewTest();   // char, string
+  TDataLoopTest::FunctionCompactTest();   // string, int
+  TDataLoopTest::FunctionMemoryUsageTest();   // string, vector, pair, int, double, char
+  TDataLoopTest::FunctionClearIncrementalTest();   // Tracked, string
   
   return 0;
 }
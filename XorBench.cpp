@@ -0,0 +1,129 @@
+#include "TDataLoop.h"
+#include "XorDataLoop.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+
+using std::cout;
+using std::endl;
+
+// compares the XOR-linked node layout of XorDataLoop with the two-pointer layout of TDataLoop
+// on a loop of n values: memory per node, building with +=, walking forward and backward,
+// rotating with operator^ and splicing
+// usage: XorBench [n] [pointer|xor] [int|pair]
+// memory is counted by operator new below, both as requested and as the allocator rounds it
+// (heap_block_bytes: a multiple of 16 bytes, with at least 32), so the saved word shows for
+// a pair of long longs (48 against 32 bytes) but not for an int (32 either way)
+
+typedef std::pair<long long, long long> Pair;
+
+/// the bytes requested from operator new so far, and the bytes the allocator is estimated to take for them
+static size_t requested = 0;
+static size_t taken = 0;
+
+void * operator new(size_t size) {
+    requested += size;
+    taken += heap_block_bytes(size);
+    void *p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, size_t) noexcept { std::free(p); }
+
+// the value stored for i
+template<typename V> V value_of(size_t i);
+template<> int value_of<int>(size_t i) { return static_cast<int>(i); }
+template<> Pair value_of<Pair>(size_t i) { return Pair(i, 0); }
+
+// the part of a value added to the checksum
+static long long key(int v) { return v; }
+static long long key(const Pair & v) { return v.first; }
+
+// returns the milliseconds since begin
+static double since(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// times each operation on a Loop of n values and prints the results under name
+template<typename Loop, typename V>
+static void run(const std::string & name, size_t n) {
+    size_t requested_before = requested;
+    size_t taken_before = taken;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Loop dl;
+    for (size_t i = 0; i < n; i++) {
+        dl += value_of<V>(i);
+    }
+    double build = since(begin);
+    double asked = static_cast<double>(requested - requested_before) / n;
+    double bytes = static_cast<double>(taken - taken_before) / n;
+
+    begin = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (typename Loop::const_iterator it = dl.begin(); it != dl.end(); ++it) {
+        sum += key(*it);
+    }
+    double forward = since(begin);
+
+    begin = std::chrono::steady_clock::now();
+    typename Loop::const_iterator it = dl.end();
+    while (it != dl.begin()) {
+        --it;
+        sum -= key(*it);
+    }
+    double backward = since(begin);
+
+    // ten rotations of a third of the loop each, alternating direction
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; i++) {
+        dl ^ (i % 2 ? -1 : 1) * static_cast<int>(n / 3);
+    }
+    double rotate = since(begin);
+
+    // a thousand small loops spliced in at the front
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; i++) {
+        Loop part;
+        part += value_of<V>(i);
+        part += value_of<V>(i);
+        dl.splice(part, 0);
+    }
+    double splice = since(begin);
+
+    cout << name << ": " << bytes << " bytes/node (" << asked << " requested), "
+         << "build " << build << " ms, forward " << forward << " ms, backward " << backward << " ms, "
+         << "rotate " << rotate << " ms, splice " << splice << " ms"
+         << (sum == 0 ? "" : " (bad sum)") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    std::string only = argc > 2 ? argv[2] : "";
+    std::string type = argc > 3 ? argv[3] : "";
+    cout << "Looping over " << n << " values" << endl;
+
+    if (type.empty() || type == "int") {
+        if (only.empty() || only == "pointer") {
+            run<TDataLoop<int>, int>("pointer int", n);
+        }
+        if (only.empty() || only == "xor") {
+            run<XorDataLoop<int>, int>("xor int", n);
+        }
+    }
+    if (type.empty() || type == "pair") {
+        if (only.empty() || only == "pointer") {
+            run<TDataLoop<Pair>, Pair>("pointer pair", n);
+        }
+        if (only.empty() || only == "xor") {
+            run<XorDataLoop<Pair>, Pair>("xor pair", n);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,280 @@
+#include "XorDataLoop.h"
+#include "TDataLoop.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using std::cout;
+using std::endl;
+using std::string;
+
+#ifndef ASSERT
+#include <csignal>  // signal handler 
+#include <cstring>  // memset
+
+char programName[128];
+
+void segFaultHandler(int, siginfo_t*, void* context) {
+  char cmdbuffer[1024];
+  char resultbuffer[128];
+#ifdef __APPLE__
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext->__ss.__rip);
+#else
+  sprintf(cmdbuffer, "addr2line -Cfip -e %s %p", programName,
+      (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+  std::string result = "";
+  FILE* pipe = popen(cmdbuffer, "r");
+  if (!pipe) throw std::runtime_error("popen() failed!");
+  try {
+    while (fgets(resultbuffer, sizeof resultbuffer, pipe) != NULL) {
+      result += resultbuffer;
+    }
+  } catch (...) {
+    pclose(pipe);
+    throw;
+  }
+  pclose(pipe);
+  cout << "Segmentation fault occured in " << result;
+#ifdef __APPLE__
+  ((ucontext_t*)context)->uc_mcontext->__ss.__rip += 2;  // skip the seg fault
+#else
+  ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP] += 2;  // skip the seg fault
+#endif
+}
+
+#define ASSERT(cond) if (!(cond)) { \
+    cout << "failed ASSERT " << #cond << " at line " << __LINE__ << endl; \
+  } else { \
+    cout << __func__ << " - (" << #cond << ")" << " passed!" << endl; \
+  }
+#endif
+
+
+/**
+ * \struct XorDataLoopTest
+ * \defgroup XorDataLoopTest
+ * \brief Test cases for the XorDataLoop class
+ */
+struct XorDataLoopTest {
+  // aliases
+  using IXDataLoop = XorDataLoop<int>;
+  using SXDataLoop = XorDataLoop<string>;
+
+  /// the layout of a TDataLoop node, value and two pointers
+  template<typename T>
+  struct PointerNode {
+    T data;
+    PointerNode *next;
+    PointerNode *prev;
+  };
+
+  /// prints any printable object, for comparing the formats of two kinds of loop
+  template<typename Loop>
+  static string text(const Loop & dl) {
+    std::stringstream ss;
+    ss << dl;
+    return ss.str();
+  }
+
+  /// walks the loop backward from start by following the links, and prints the values met
+  static string backward(const IXDataLoop & dl) {
+    std::stringstream ss;
+    IXDataLoop::const_iterator it = dl.end();
+    while (it != dl.begin()) {
+      --it;
+      ss << *it << " ";
+    }
+    return ss.str();
+  }
+
+  /**
+   * \brief A test function for the constructors and the node layout
+   */
+  static void ConstructorTest() {
+    IXDataLoop empty;
+    ASSERT(empty.start == nullptr);
+    ASSERT(empty.last == nullptr);
+    ASSERT(empty.count == 0);
+    ASSERT(text(empty) == ">no values<");
+    ASSERT(empty.begin() == empty.end());
+
+    IXDataLoop one(5);
+    ASSERT(one.count == 1);
+    ASSERT(one.start == one.last);
+    ASSERT(one.start->link == 0);
+
+    // one link word instead of two pointers
+    ASSERT(sizeof(IXDataLoop::_Node) + sizeof(void *) == sizeof(PointerNode<int>));
+    ASSERT(sizeof(SXDataLoop::_Node) + sizeof(void *) == sizeof(PointerNode<string>));
+
+    SXDataLoop s("hi");
+    s += "there";
+    SXDataLoop copy(s);
+    ASSERT(copy == s);
+    SXDataLoop moved(std::move(copy));
+    ASSERT(moved == s);
+    ASSERT(copy.length() == 0);
+    ASSERT(copy.start == nullptr);
+
+    // my tests
+    SXDataLoop a;
+    a = s;
+    a = a;
+    ASSERT(a == s);
+    a = SXDataLoop();
+    ASSERT(a.length() == 0);
+  }
+
+  /**
+   * \brief A test function for operator+=, operator+ and the iterators
+   */
+  static void OperatorPlusGetsTest() {
+    IXDataLoop a;
+    TDataLoop<int> t;
+    for (int i = 1; i <= 5; i++) {
+      a += i;
+      t += i;
+    }
+    ASSERT(a.length() == 5);
+    ASSERT(text(a) == "-> 1 <--> 2 <--> 3 <--> 4 <--> 5 <-");
+    ASSERT(text(a) == text(t));
+    ASSERT(backward(a) == "5 4 3 2 1 ");
+    ASSERT(a.last->data == 5);
+
+    IXDataLoop b(6);
+    IXDataLoop c = a + b;
+    ASSERT(text(c) == "-> 1 <--> 2 <--> 3 <--> 4 <--> 5 <--> 6 <-");
+    ASSERT(a.length() == 5);
+    ASSERT(text(IXDataLoop() + IXDataLoop()) == ">no values<");
+
+    IXDataLoop::iterator it = a.begin();
+    it++;
+    *it = 20;
+    IXDataLoop::const_iterator cit = it;
+    ASSERT(*cit-- == 20);
+    ASSERT(*cit == 1);
+    ASSERT(cit == a.begin());
+
+    // my tests
+    IXDataLoop two;
+    two += 1;
+    two += 2;
+    ASSERT(backward(two) == "2 1 ");
+    ASSERT(!(two == a));
+  }
+
+  /**
+   * \brief A test function for operator^
+   */
+  static void OperatorShiftTest() {
+    IXDataLoop a;
+    TDataLoop<int> t;
+    for (int i = 1; i <= 7; i++) {
+      a += i;
+      t += i;
+    }
+
+    int offsets[] = {2, -3, 11, -12, 0, 4, -1, 8};
+    bool same = true;
+    for (int offset : offsets) {
+      a ^ offset;
+      t ^ offset;
+      same = same && text(a) == text(t);
+    }
+    ASSERT(same);
+    ASSERT(text(a) == "-> 3 <--> 4 <--> 5 <--> 6 <--> 7 <--> 1 <--> 2 <-");
+    ASSERT(backward(a) == "2 1 7 6 5 4 3 ");
+
+    // adding after a rotation goes before the new start
+    a += 8;
+    ASSERT(text(a) == "-> 3 <--> 4 <--> 5 <--> 6 <--> 7 <--> 1 <--> 2 <--> 8 <-");
+
+    // my tests
+    IXDataLoop empty;
+    empty ^ 3;
+    ASSERT(empty.length() == 0);
+  }
+
+  /**
+   * \brief A test function for splice
+   */
+  static void FunctionSpliceTest() {
+    // the same positions as DataLoop, including those past the end, for several sizes of each loop
+    bool same = true;
+    for (int n = 0; n <= 4; n++) {
+      for (int m = 0; m <= 3; m++) {
+        for (size_t pos = 0; pos < 9; pos++) {
+          IXDataLoop a;
+          IXDataLoop b;
+          TDataLoop<int> ta;
+          TDataLoop<int> tb;
+          for (int i = 1; i <= n; i++) {
+            a += i;
+            ta += i;
+          }
+          for (int i = 7; i < 7 + m; i++) {
+            b += i;
+            tb += i;
+          }
+          a.splice(b, pos);
+          ta.splice(tb, pos);
+
+          // the links must hold in both directions, and += must still add at the end
+          std::stringstream back;
+          for (auto it = ta.end(); it != ta.begin(); ) {
+            back << *--it << " ";
+          }
+          same = same && text(a) == text(ta) && backward(a) == back.str() && b.length() == 0;
+          a += 100;
+          ta += 100;
+          same = same && text(a) == text(ta);
+        }
+      }
+    }
+    ASSERT(same);
+
+    IXDataLoop a;
+    a += 1;
+    a += 2;
+    IXDataLoop b;
+    b += 3;
+    b += 4;
+    b ^ 1;
+    a.splice(b, 1);
+    ASSERT(text(a) == "-> 1 <--> 4 <--> 3 <--> 2 <-");
+    ASSERT(b.start == nullptr);
+    a.splice(a, 2);
+    ASSERT(a.length() == 4);
+
+    // my tests
+    SXDataLoop s;
+    s += "x";
+    SXDataLoop r;
+    r += "y";
+    r += "z";
+    s.splice(r, 0);
+    ASSERT(text(s) == "-> y <--> z <--> x <-");
+    s ^ -1;
+    ASSERT(text(s) == "-> x <--> y <--> z <-");
+  }
+};
+
+int main(int, char* argv[]) {
+  cout << "Testing XorDataLoop" << endl;
+  // register a seg fault handler
+  sprintf(programName, "%s", argv[0]);
+  struct sigaction signalAction;
+  memset(&signalAction, 0, sizeof(struct sigaction));
+  signalAction.sa_flags = SA_SIGINFO;
+  signalAction.sa_sigaction = segFaultHandler;
+  sigaction(SIGSEGV, &signalAction, NULL);
+
+  XorDataLoopTest::ConstructorTest();   // int, string
+  XorDataLoopTest::OperatorPlusGetsTest();   // int
+  XorDataLoopTest::OperatorShiftTest();   // int
+  XorDataLoopTest::FunctionSpliceTest();   // int, string
+  
+  return 0;
+}